@@ -48,6 +48,10 @@ typedef struct AmlRootNode {
 
   /// ACPI DSDT/SSDT header.
   EFI_ACPI_DESCRIPTION_HEADER    *SdtHeader;
+
+  /// Index of the namespace nodes of the tree, used by AmlFindNode().
+  /// NULL until the first search.
+  struct AmlNameSpaceIndex       *NameSpaceIndex;
 } AML_ROOT_NODE;
 
 /** Root Node handle.
@@ -124,6 +124,48 @@ typedef struct AmlPathSearchContext {
   AML_NODE_HEADER    *OutNode;
 } AML_PATH_SEARCH_CONTEXT;
 
+/** Number of hash buckets of a namespace index.
+*/
+#define AML_NAMESPACE_INDEX_BUCKET_COUNT  256
+
+/** Namespace index of a tree.
+
+  Raw AML absolute paths of the namespace nodes of a tree, hashed to
+  speed up AmlFindNode(). The index is built on the first search. Nodes
+  attached afterwards are added to it, and it is dropped when a node is
+  detached or renamed.
+*/
+typedef struct AmlNameSpaceIndex {
+  /// Hash buckets of AML_NAMESPACE_INDEX_ENTRY.
+  LIST_ENTRY    Buckets[AML_NAMESPACE_INDEX_BUCKET_COUNT];
+} AML_NAMESPACE_INDEX;
+
+/** Entry of a namespace index.
+
+  The raw AML absolute path of the node follows the structure.
+*/
+typedef struct AmlNameSpaceIndexEntry {
+  /// Link in the hash bucket. Must be the first field of the struct.
+  LIST_ENTRY         Link;
+
+  /// Namespace node.
+  AML_NODE_HEADER    *Node;
+
+  /// Size of the raw AML absolute path of the node.
+  UINT32             PathSize;
+} AML_NAMESPACE_INDEX_ENTRY;
+
+/** Context of the enumeration adding nodes to a namespace index.
+*/
+typedef struct AmlNameSpaceIndexContext {
+  /// Namespace index to add the nodes to.
+  AML_NAMESPACE_INDEX    *Index;
+
+  /// Backward stream holding a pre-allocated buffer, used to query the
+  /// raw AML absolute path of the enumerated nodes.
+  AML_STREAM             *PathBStream;
+} AML_NAMESPACE_INDEX_CONTEXT;
+
 /** Return the first AML namespace node up in the parent hierarchy.
 
     Return the root node if no namespace node is found is the hierarchy.
@@ -1198,6 +1240,350 @@ exit_handler:
   return ContinueEnum;
 }
 
+/** Get the root node of the tree a node is attached to.
+
+  Contrary to AmlGetRootNode(), it is not an error for the node
+  to be detached from any tree.
+
+  @param  [in]  Node    Pointer to a node.
+
+  @return The root node of the tree.
+          NULL if Node is not attached to a root node.
+**/
+STATIC
+AML_ROOT_NODE *
+EFIAPI
+AmlNameSpaceIndexGetRoot (
+  IN  CONST AML_NODE_HEADER  *Node
+  )
+{
+  while (IS_AML_DATA_NODE (Node) || IS_AML_OBJECT_NODE (Node)) {
+    Node = Node->Parent;
+  }
+
+  return IS_AML_ROOT_NODE (Node) ? (AML_ROOT_NODE *)Node : NULL;
+}
+
+/** Compute the hash bucket of a raw AML absolute path.
+
+  @param  [in]  Path      Raw AML absolute path.
+  @param  [in]  PathSize  Size of the path.
+
+  @return Index of the hash bucket.
+**/
+STATIC
+UINT32
+EFIAPI
+AmlNameSpaceIndexHash (
+  IN  CONST CHAR8   *Path,
+  IN        UINT32  PathSize
+  )
+{
+  UINT32  Hash;
+
+  // FNV-1a.
+  Hash = 2166136261;
+  while (PathSize-- > 0) {
+    Hash = (Hash ^ (UINT8)*Path++) * 16777619;
+  }
+
+  return Hash % AML_NAMESPACE_INDEX_BUCKET_COUNT;
+}
+
+/** Free the namespace index of a tree.
+
+  @param  [in]  RootNode  Root node of the tree.
+**/
+STATIC
+VOID
+EFIAPI
+AmlNameSpaceIndexFree (
+  IN  AML_ROOT_NODE  *RootNode
+  )
+{
+  UINT32                     Index;
+  AML_NAMESPACE_INDEX_ENTRY  *Entry;
+
+  if (RootNode->NameSpaceIndex == NULL) {
+    return;
+  }
+
+  for (Index = 0; Index < AML_NAMESPACE_INDEX_BUCKET_COUNT; Index++) {
+    while (!IsListEmpty (&RootNode->NameSpaceIndex->Buckets[Index])) {
+      Entry = (AML_NAMESPACE_INDEX_ENTRY *)GetFirstNode (
+                                             &RootNode->NameSpaceIndex->Buckets[Index]
+                                             );
+      RemoveEntryList (&Entry->Link);
+      FreePool (Entry);
+    }
+  }
+
+  FreePool (RootNode->NameSpaceIndex);
+  RootNode->NameSpaceIndex = NULL;
+}
+
+/** Callback function adding each namespace node to a namespace index.
+
+  @param  [in]      Node      Pointer to the node being enumerated.
+  @param  [in, out] Context   A pointer to AML_NAMESPACE_INDEX_CONTEXT.
+  @param  [in, out] Status    At entry, contains the status returned by the
+                              last call to this exact function during the
+                              enumeration.
+                              As exit, contains the returned status of the
+                              call to this function.
+                              Optional, can be NULL.
+
+  @retval TRUE if the enumeration can continue or has finished without
+          interruption.
+  @retval FALSE if the enumeration needs to stopped or has stopped.
+**/
+STATIC
+BOOLEAN
+EFIAPI
+AmlNameSpaceIndexAddCallback (
+  IN      AML_NODE_HEADER  *Node,
+  IN  OUT VOID             *Context,
+  IN  OUT EFI_STATUS       *Status   OPTIONAL
+  )
+{
+  EFI_STATUS  Status1;
+
+  AML_NAMESPACE_INDEX_CONTEXT  *IndexContext;
+  AML_NAMESPACE_INDEX_ENTRY    *Entry;
+  UINT32                       PathSize;
+  UINT32                       BucketIndex;
+
+  Status1 = EFI_SUCCESS;
+
+  if (!AmlNodeHasAttribute (
+         (CONST AML_OBJECT_NODE *)Node,
+         AML_IN_NAMESPACE
+         ))
+  {
+    goto exit_handler;
+  }
+
+  IndexContext = (AML_NAMESPACE_INDEX_CONTEXT *)Context;
+
+  Status1 = AmlStreamReset (IndexContext->PathBStream);
+  if (EFI_ERROR (Status1)) {
+    ASSERT (0);
+    goto exit_handler;
+  }
+
+  Status1 = AmlGetRawNameSpacePath (Node, 0, IndexContext->PathBStream);
+  if (EFI_ERROR (Status1)) {
+    ASSERT (0);
+    goto exit_handler;
+  }
+
+  PathSize = AmlStreamGetIndex (IndexContext->PathBStream);
+  Entry    = AllocatePool (sizeof (AML_NAMESPACE_INDEX_ENTRY) + PathSize);
+  if (Entry == NULL) {
+    ASSERT (0);
+    Status1 = EFI_OUT_OF_RESOURCES;
+    goto exit_handler;
+  }
+
+  Entry->Node     = Node;
+  Entry->PathSize = PathSize;
+  CopyMem (
+    Entry + 1,
+    AmlStreamGetCurrPos (IndexContext->PathBStream),
+    PathSize
+    );
+  BucketIndex = AmlNameSpaceIndexHash ((CONST CHAR8 *)(Entry + 1), PathSize);
+  InsertTailList (&IndexContext->Index->Buckets[BucketIndex], &Entry->Link);
+
+exit_handler:
+  if (Status != NULL) {
+    *Status = Status1;
+  }
+
+  return !EFI_ERROR (Status1);
+}
+
+/** Add the namespace nodes of a subtree to a namespace index.
+
+  @param  [in]  Index   Namespace index.
+  @param  [in]  Node    Subtree to add. Must be attached to the tree the
+                        index belongs to.
+
+  @retval EFI_SUCCESS             The function completed successfully.
+  @retval EFI_BUFFER_TOO_SMALL    No space left in the buffer.
+  @retval EFI_INVALID_PARAMETER   Invalid parameter.
+  @retval EFI_OUT_OF_RESOURCES    Out of memory.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+AmlNameSpaceIndexAdd (
+  IN  AML_NAMESPACE_INDEX  *Index,
+  IN  AML_NODE_HEADER      *Node
+  )
+{
+  EFI_STATUS  Status;
+
+  AML_NAMESPACE_INDEX_CONTEXT  IndexContext;
+  AML_STREAM                   PathBStream;
+  CHAR8                        *PathBuffer;
+
+  PathBuffer = AllocateZeroPool (MAX_ASL_NAMESTRING_SIZE);
+  if (PathBuffer == NULL) {
+    ASSERT (0);
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = AmlStreamInit (
+             &PathBStream,
+             (UINT8 *)PathBuffer,
+             MAX_ASL_NAMESTRING_SIZE,
+             EAmlStreamDirectionBackward
+             );
+  if (EFI_ERROR (Status)) {
+    ASSERT (0);
+    goto exit_handler;
+  }
+
+  IndexContext.Index       = Index;
+  IndexContext.PathBStream = &PathBStream;
+
+  AmlEnumTree (
+    Node,
+    AmlNameSpaceIndexAddCallback,
+    (VOID *)&IndexContext,
+    &Status
+    );
+
+exit_handler:
+  FreePool (PathBuffer);
+
+  return Status;
+}
+
+/** Look up a raw AML absolute path in the namespace index of a tree.
+
+  The index is built on first use.
+
+  @param  [in]  RootNode  Root node of the tree.
+  @param  [in]  Path      Raw AML absolute path of the searched node.
+  @param  [in]  PathSize  Size of the path.
+  @param  [out] OutNode   The found node.
+                          NULL if no node has this path.
+
+  @retval TRUE    The index resolved the path.
+  @retval FALSE   The index could not be built, or several nodes have this
+                  path. The tree must be enumerated to find the first one.
+**/
+STATIC
+BOOLEAN
+EFIAPI
+AmlNameSpaceIndexLookup (
+  IN  AML_ROOT_NODE    *RootNode,
+  IN  CONST CHAR8      *Path,
+  IN        UINT32     PathSize,
+  OUT AML_NODE_HEADER  **OutNode
+  )
+{
+  EFI_STATUS  Status;
+
+  UINT32                     Index;
+  LIST_ENTRY                 *Bucket;
+  LIST_ENTRY                 *Link;
+  AML_NAMESPACE_INDEX_ENTRY  *Entry;
+
+  *OutNode = NULL;
+
+  if (RootNode->NameSpaceIndex == NULL) {
+    RootNode->NameSpaceIndex = AllocatePool (sizeof (AML_NAMESPACE_INDEX));
+    if (RootNode->NameSpaceIndex == NULL) {
+      return FALSE;
+    }
+
+    for (Index = 0; Index < AML_NAMESPACE_INDEX_BUCKET_COUNT; Index++) {
+      InitializeListHead (&RootNode->NameSpaceIndex->Buckets[Index]);
+    }
+
+    Status = AmlNameSpaceIndexAdd (
+               RootNode->NameSpaceIndex,
+               (AML_NODE_HEADER *)RootNode
+               );
+    if (EFI_ERROR (Status)) {
+      AmlNameSpaceIndexFree (RootNode);
+      return FALSE;
+    }
+  }
+
+  Bucket = &RootNode->NameSpaceIndex->Buckets[AmlNameSpaceIndexHash (Path, PathSize)];
+  for (Link = GetFirstNode (Bucket); !IsNull (Bucket, Link); Link = GetNextNode (Bucket, Link)) {
+    Entry = (AML_NAMESPACE_INDEX_ENTRY *)Link;
+    if ((Entry->PathSize == PathSize) &&
+        (CompareMem (Entry + 1, Path, PathSize) == 0))
+    {
+      if (*OutNode != NULL) {
+        // Several nodes have this path. Only the enumeration order
+        // tells which one is found first.
+        *OutNode = NULL;
+        return FALSE;
+      }
+
+      *OutNode = Entry->Node;
+    }
+  }
+
+  return TRUE;
+}
+
+/** Add the namespace nodes of a subtree that has just been attached to a tree
+    to the namespace index of this tree, if any.
+
+  If the index cannot be updated, it is dropped and rebuilt on the next
+  search.
+
+  @param  [in]  Node    Root of the attached subtree.
+**/
+VOID
+EFIAPI
+AmlNameSpaceIndexAddTree (
+  IN  AML_NODE_HEADER  *Node
+  )
+{
+  EFI_STATUS     Status;
+  AML_ROOT_NODE  *RootNode;
+
+  RootNode = AmlNameSpaceIndexGetRoot (Node);
+  if ((RootNode == NULL) || (RootNode->NameSpaceIndex == NULL)) {
+    return;
+  }
+
+  Status = AmlNameSpaceIndexAdd (RootNode->NameSpaceIndex, Node);
+  if (EFI_ERROR (Status)) {
+    AmlNameSpaceIndexFree (RootNode);
+  }
+}
+
+/** Drop the namespace index of the tree a node is attached to, if any.
+
+  This must be called before a node is detached from a tree, and when a
+  change can rename a namespace node. The index is rebuilt on the next
+  search.
+
+  @param  [in]  Node    Pointer to a node of the tree, or to its root node.
+**/
+VOID
+EFIAPI
+AmlNameSpaceIndexInvalidate (
+  IN  AML_NODE_HEADER  *Node
+  )
+{
+  AML_ROOT_NODE  *RootNode;
+
+  RootNode = AmlNameSpaceIndexGetRoot (Node);
+  if (RootNode != NULL) {
+    AmlNameSpaceIndexFree (RootNode);
+  }
+}
+
 /** Build a raw AML absolute path from a reference node and a relative
     ASL path.
 
@@ -1459,7 +1845,21 @@ AmlFindNode (
     goto exit_handler;
   }
 
-  // 4. Create a backward stream large enough to hold the current node path
+  // 4. Look the path up in the namespace index of the tree. The index
+  //    cannot tell which node is found first if several nodes have the
+  //    same path. In this case, enumerate the tree.
+  if (AmlNameSpaceIndexLookup (
+        RootNode,
+        (CONST CHAR8 *)AmlStreamGetCurrPos (&RawAmlAbsSearchPathBStream),
+        AmlStreamGetIndex (&RawAmlAbsSearchPathBStream),
+        OutNode
+        ))
+  {
+    Status = (*OutNode == NULL) ? EFI_NOT_FOUND : EFI_SUCCESS;
+    goto exit_handler;
+  }
+
+  // 5. Create a backward stream large enough to hold the current node path
   //    during enumeration. This prevents from doing multiple allocation/free
   //    operations.
   RawAmlAbsCurrNodePathBufferSize = MAX_ASL_NAMESTRING_SIZE;
@@ -1483,7 +1883,7 @@ AmlFindNode (
     goto exit_handler;
   }
 
-  // 5. Fill a path search context structure with:
+  // 6. Fill a path search context structure with:
   //     - SearchPathStream: backward stream containing the raw absolute AML
   //       path to the searched node;
   //     - CurrNodePathStream: backward stream containing the raw absolute AML
@@ -1493,7 +1893,7 @@ AmlFindNode (
   PathSearchContext.CurrNodePathBStream = &RawAmlAbsCurrNodePathBStream;
   PathSearchContext.OutNode             = NULL;
 
-  // 6. Iterate through the namespace nodes of the tree.
+  // 7. Iterate through the namespace nodes of the tree.
   //    For each namespace node, build its raw AML absolute path. Then compare
   //    it with the search path.
   AmlEnumTree (
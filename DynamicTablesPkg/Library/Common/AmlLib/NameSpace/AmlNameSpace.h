@@ -71,4 +71,32 @@ AmlGetRawNameSpacePath (
   OUT       AML_STREAM       *RawAbsPathBStream
   );
 
+/** Add the namespace nodes of a subtree that has just been attached to a tree
+    to the namespace index of this tree, if any.
+
+  If the index cannot be updated, it is dropped and rebuilt on the next
+  search.
+
+  @param  [in]  Node    Root of the attached subtree.
+**/
+VOID
+EFIAPI
+AmlNameSpaceIndexAddTree (
+  IN  AML_NODE_HEADER  *Node
+  );
+
+/** Drop the namespace index of the tree a node is attached to, if any.
+
+  This must be called before a node is detached from a tree, and when a
+  change can rename a namespace node. The index is rebuilt on the next
+  search.
+
+  @param  [in]  Node    Pointer to a node of the tree, or to its root node.
+**/
+VOID
+EFIAPI
+AmlNameSpaceIndexInvalidate (
+  IN  AML_NODE_HEADER  *Node
+  );
+
 #endif // AML_NAMESPACE_H_
@@ -9,6 +9,7 @@
 #include <Tree/AmlNode.h>
 
 #include <AmlCoreInterface.h>
+#include <NameSpace/AmlNameSpace.h>
 #include <Tree/AmlTree.h>
 
 /** Initialize an AML_NODE_HEADER structure.
@@ -63,6 +64,8 @@ AmlDeleteRootNode (
     return EFI_INVALID_PARAMETER;
   }
 
+  AmlNameSpaceIndexInvalidate ((AML_NODE_HEADER *)RootNode);
+
   if ((RootNode->SdtHeader != NULL)) {
     FreePool (RootNode->SdtHeader);
   } else {
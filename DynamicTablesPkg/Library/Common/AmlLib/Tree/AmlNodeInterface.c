@@ -9,6 +9,7 @@
 #include <AmlNodeDefines.h>
 
 #include <AmlCoreInterface.h>
+#include <NameSpace/AmlNameSpace.h>
 #include <ResourceData/AmlResourceData.h>
 #include <String/AmlString.h>
 #include <Tree/AmlNode.h>
@@ -451,6 +452,8 @@ AmlUpdateDataNode (
         return Status;
       }
 
+      // The name of a namespace node can change.
+      AmlNameSpaceIndexInvalidate ((AML_NODE_HEADER *)DataNode);
       break;
     }
     case EAmlNodeDataTypeString:
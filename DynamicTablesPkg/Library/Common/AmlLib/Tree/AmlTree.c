@@ -9,6 +9,7 @@
 #include <Tree/AmlTree.h>
 
 #include <AmlCoreInterface.h>
+#include <NameSpace/AmlNameSpace.h>
 #include <Tree/AmlNode.h>
 #include <Tree/AmlTreeTraversal.h>
 #include <Utils/AmlUtility.h>
@@ -171,12 +172,27 @@ AmlSetFixedArgument (
   IN  AML_NODE_HEADER   *NewNode
   )
 {
+  AML_NODE_HEADER  *OldNode;
+
   if (IS_AML_OBJECT_NODE (ObjectNode)                                     &&
       (Index <= (EAML_PARSE_INDEX)AmlGetFixedArgumentCount (ObjectNode))  &&
       ((NewNode == NULL)                                                  ||
        IS_AML_OBJECT_NODE (NewNode)                                       ||
        IS_AML_DATA_NODE (NewNode)))
   {
+    // Replacing a NameString or an object can rename or remove
+    // namespace nodes.
+    OldNode = ObjectNode->FixedArgs[Index];
+    if (IS_AML_OBJECT_NODE (OldNode)                                       ||
+        IS_AML_OBJECT_NODE (NewNode)                                       ||
+        (IS_AML_DATA_NODE (OldNode)                                        &&
+         (((AML_DATA_NODE *)OldNode)->DataType == EAmlNodeDataTypeNameString)) ||
+        (IS_AML_DATA_NODE (NewNode)                                        &&
+         (((AML_DATA_NODE *)NewNode)->DataType == EAmlNodeDataTypeNameString)))
+    {
+      AmlNameSpaceIndexInvalidate ((AML_NODE_HEADER *)ObjectNode);
+    }
+
     ObjectNode->FixedArgs[Index] = NewNode;
 
     // If NewNode is a data node or an object node, set its parent.
@@ -263,6 +279,9 @@ AmlRemoveNodeFromVarArgList (
     return EFI_INVALID_PARAMETER;
   }
 
+  // Namespace nodes in the subtree are no longer reachable.
+  AmlNameSpaceIndexInvalidate (Node);
+
   // Unlink Node from the tree.
   RemoveEntryList (&Node->Link);
   InitializeListHead (&Node->Link);
@@ -347,6 +366,8 @@ AmlVarListAddHead (
   InsertHeadList (ChildrenList, &NewNode->Link);
   NewNode->Parent = ParentNode;
 
+  AmlNameSpaceIndexAddTree (NewNode);
+
   // Get the size of the NewNode.
   Status = AmlComputeSize (NewNode, &NewSize);
   if (EFI_ERROR (Status)) {
@@ -405,6 +426,8 @@ AmlVarListAddTailInternal (
   InsertTailList (ChildrenList, &NewNode->Link);
   NewNode->Parent = ParentNode;
 
+  AmlNameSpaceIndexAddTree (NewNode);
+
   return EFI_SUCCESS;
 }
 
@@ -491,6 +514,8 @@ AmlVarListAddBefore (
   InsertTailList (&Node->Link, &NewNode->Link);
   NewNode->Parent = ParentNode;
 
+  AmlNameSpaceIndexAddTree (NewNode);
+
   // Get the size of the NewNode.
   Status = AmlComputeSize (NewNode, &NewSize);
   if (EFI_ERROR (Status)) {
@@ -547,6 +572,8 @@ AmlVarListAddAfter (
   InsertHeadList (&Node->Link, &NewNode->Link);
   NewNode->Parent = ParentNode;
 
+  AmlNameSpaceIndexAddTree (NewNode);
+
   // Get the size of the NewNode.
   Status = AmlComputeSize (NewNode, &NewSize);
   if (EFI_ERROR (Status)) {
@@ -862,6 +889,9 @@ AmlReplaceVariableArgument (
     }
   }
 
+  // Namespace nodes in the OldNode subtree are no longer reachable.
+  AmlNameSpaceIndexInvalidate (OldNode);
+
   // Unlink OldNode from the tree.
   NextLink = RemoveEntryList (&OldNode->Link);
   InitializeListHead (&OldNode->Link);
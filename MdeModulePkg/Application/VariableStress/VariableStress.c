@@ -0,0 +1,196 @@
+/** @file
+  A shell application that measures the latency of SetVariable() under churn.
+
+  The application repeatedly creates, updates and deletes a set of non-volatile
+  variables, so that the variable store fills up and has to be reclaimed. Each
+  call is timed, and the minimum, average and maximum latencies are printed.
+  With an SMM variable driver, the maximum latency is the worst case time spent
+  in the SMI handler, which is dominated by the reclaim of the variable store.
+
+  The application needs a TimerLib instance backed by a real performance
+  counter. It exits if the counter reports no range. The instance in
+  MdeModulePkg.dsc is BaseTimerLibNullTemplate, which asserts when it is
+  called, so that build is only a build check.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/UefiLib.h>
+#include <Library/UefiApplicationEntryPoint.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/BaseLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/PrintLib.h>
+#include <Library/TimerLib.h>
+#include <Library/UefiRuntimeServicesTableLib.h>
+
+#define VARIABLE_STRESS_ITERATIONS  4096
+#define VARIABLE_STRESS_NAME_COUNT  16
+#define VARIABLE_STRESS_DATA_SIZE   512
+#define VARIABLE_STRESS_ATTRIBUTES  (EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS)
+
+//
+// Vendor GUID of the variables created by this application.
+//
+STATIC EFI_GUID  mVariableStressGuid = {
+  0x957cb717, 0xb3cf, 0x4d76, { 0x90, 0xa8, 0x6f, 0x2f, 0xb2, 0xec, 0x78, 0x49 }
+};
+
+//
+// TRUE if the performance counter counts up.
+//
+STATIC BOOLEAN  mCounterCountsUp;
+
+/**
+  Call SetVariable() and measure the time it takes.
+
+  @param[in]  VariableName  Name of the variable.
+  @param[in]  DataSize      Size of Data, 0 to delete the variable.
+  @param[in]  Data          Data of the variable.
+  @param[out] Elapsed       Time spent in SetVariable() in nanoseconds.
+
+  @return The status returned by SetVariable().
+
+**/
+EFI_STATUS
+TimedSetVariable (
+  IN  CHAR16  *VariableName,
+  IN  UINTN   DataSize,
+  IN  VOID    *Data,
+  OUT UINT64  *Elapsed
+  )
+{
+  EFI_STATUS  Status;
+  UINT64      Start;
+  UINT64      End;
+
+  Start  = GetPerformanceCounter ();
+  Status = gRT->SetVariable (
+                  VariableName,
+                  &mVariableStressGuid,
+                  VARIABLE_STRESS_ATTRIBUTES,
+                  DataSize,
+                  Data
+                  );
+  End = GetPerformanceCounter ();
+
+  if (mCounterCountsUp) {
+    *Elapsed = GetTimeInNanoSecond (End - Start);
+  } else {
+    *Elapsed = GetTimeInNanoSecond (Start - End);
+  }
+
+  return Status;
+}
+
+/**
+  The user Entry Point for Application. The user code starts with this function
+  as the real entry point for the image goes into a library that calls this
+  function.
+
+  @param[in] ImageHandle    The firmware allocated handle for the EFI image.
+  @param[in] SystemTable    A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS       The entry point is executed successfully.
+  @retval other             Some error occurs when executing this entry point.
+
+**/
+EFI_STATUS
+EFIAPI
+UefiMain (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS  Status;
+  UINT8       *Data;
+  CHAR16      VariableName[16];
+  UINTN       Iteration;
+  UINTN       Index;
+  UINTN       DataSize;
+  UINTN       Calls;
+  UINT64      Elapsed;
+  UINT64      Total;
+  UINT64      Minimum;
+  UINT64      Maximum;
+  UINTN       MaximumIteration;
+  UINT64      StartValue;
+  UINT64      EndValue;
+
+  StartValue = 0;
+  EndValue   = 0;
+  if ((GetPerformanceCounterProperties (&StartValue, &EndValue) == 0) || (StartValue == EndValue)) {
+    Print (L"No performance counter is available\n");
+    return EFI_UNSUPPORTED;
+  }
+
+  mCounterCountsUp = (BOOLEAN)(EndValue > StartValue);
+
+  Data = AllocatePool (VARIABLE_STRESS_DATA_SIZE);
+  if (Data == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status           = EFI_SUCCESS;
+  Calls            = 0;
+  Total            = 0;
+  Minimum          = MAX_UINT64;
+  Maximum          = 0;
+  MaximumIteration = 0;
+
+  for (Iteration = 0; Iteration < VARIABLE_STRESS_ITERATIONS; Iteration++) {
+    Index = Iteration % VARIABLE_STRESS_NAME_COUNT;
+    UnicodeSPrint (VariableName, sizeof (VariableName), L"VarStress%02u", (UINT32)Index);
+
+    //
+    // Every variable is written twice, then deleted, which leaves two
+    // obsolete copies in the store for each pass over the names.
+    //
+    if ((Iteration / VARIABLE_STRESS_NAME_COUNT) % 3 == 2) {
+      DataSize = 0;
+    } else {
+      DataSize = VARIABLE_STRESS_DATA_SIZE;
+      SetMem (Data, DataSize, (UINT8)(Iteration + Index));
+    }
+
+    Status = TimedSetVariable (VariableName, DataSize, Data, &Elapsed);
+    if (EFI_ERROR (Status)) {
+      Print (L"SetVariable (%s) failed at iteration %u - %r\n", VariableName, (UINT32)Iteration, Status);
+      break;
+    }
+
+    Calls++;
+    Total += Elapsed;
+    if (Elapsed < Minimum) {
+      Minimum = Elapsed;
+    }
+
+    if (Elapsed > Maximum) {
+      Maximum          = Elapsed;
+      MaximumIteration = Iteration;
+    }
+  }
+
+  //
+  // Clean up the variables left in the store.
+  //
+  for (Index = 0; Index < VARIABLE_STRESS_NAME_COUNT; Index++) {
+    UnicodeSPrint (VariableName, sizeof (VariableName), L"VarStress%02u", (UINT32)Index);
+    gRT->SetVariable (VariableName, &mVariableStressGuid, VARIABLE_STRESS_ATTRIBUTES, 0, NULL);
+  }
+
+  FreePool (Data);
+
+  if (Calls == 0) {
+    return Status;
+  }
+
+  Print (L"SetVariable calls: %u (%u bytes of data)\n", (UINT32)Calls, VARIABLE_STRESS_DATA_SIZE);
+  Print (L"  Minimum: %ld ns\n", Minimum);
+  Print (L"  Average: %ld ns\n", DivU64x64Remainder (Total, Calls, NULL));
+  Print (L"  Maximum: %ld ns (iteration %u)\n", Maximum, (UINT32)MaximumIteration);
+
+  return Status;
+}
@@ -38,11 +38,15 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/DevicePathLib.h>
 #include <Library/PcdLib.h>
+#include <Library/PerformanceLib.h>
+#include <Library/PrintLib.h>
 
 #include <IndustryStandard/Pci.h>
 #include <IndustryStandard/PeImage.h>
 #include <IndustryStandard/Acpi.h>
 
+#include <Guid/ExtendedFirmwarePerformance.h>
+
 typedef struct _PCI_IO_DEVICE  PCI_IO_DEVICE;
 typedef struct _PCI_BAR        PCI_BAR;
 
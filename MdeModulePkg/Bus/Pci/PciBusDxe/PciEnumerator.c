@@ -129,6 +129,7 @@ PciRootBridgeEnumerator (
   UINT8                              Desc;
   UINT64                             AddrLen;
   UINT64                             AddrRangeMin;
+  CHAR8                              PerfToken[FPDT_STRING_EVENT_RECORD_NAME_LENGTH];
 
   SubBusNumber   = 0;
   StartBusNumber = 0;
@@ -200,6 +201,18 @@ PciRootBridgeEnumerator (
   //
   SubBusNumber = StartBusNumber;
 
+  //
+  // Log the scanning time of each root bridge in the performance log
+  //
+  AsciiSPrint (
+    PerfToken,
+    sizeof (PerfToken),
+    "PciScan %04x:%02x",
+    RootBridgeDev->PciRootBridgeIo->SegmentNumber,
+    StartBusNumber
+    );
+  PERF_INMODULE_BEGIN (PerfToken);
+
   //
   // Reset all assigned PCI bus number
   //
@@ -218,10 +231,20 @@ PciRootBridgeEnumerator (
              &PaddedBusRange
              );
 
+  PERF_INMODULE_END (PerfToken);
+
   if (EFI_ERROR (Status)) {
     return Status;
   }
 
+  DEBUG ((
+    DEBUG_INFO,
+    "PCI Root Bridge %04x:%02x scanned, subordinate bus %02x\n",
+    RootBridgeDev->PciRootBridgeIo->SegmentNumber,
+    StartBusNumber,
+    SubBusNumber
+    ));
+
   //
   // Assign max bus number scanned
   //
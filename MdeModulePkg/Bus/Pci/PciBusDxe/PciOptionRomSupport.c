@@ -449,11 +449,16 @@ LoadOpRomImage (
   LegacyImageLength = 0;
 
   do {
+    //
+    // The ROM image header is 512-byte aligned and the PCI Data Structure is
+    // DWORD aligned, so read them with wider accesses than byte to reduce the
+    // number of slow ROM BAR transactions.
+    //
     PciDevice->PciRootBridgeIo->Mem.Read (
                                       PciDevice->PciRootBridgeIo,
-                                      EfiPciWidthUint8,
+                                      EfiPciWidthUint16,
                                       RomBarOffset,
-                                      sizeof (PCI_EXPANSION_ROM_HEADER),
+                                      sizeof (PCI_EXPANSION_ROM_HEADER) / sizeof (UINT16),
                                       (UINT8 *)RomHeader
                                       );
 
@@ -482,9 +487,9 @@ LoadOpRomImage (
 
     PciDevice->PciRootBridgeIo->Mem.Read (
                                       PciDevice->PciRootBridgeIo,
-                                      EfiPciWidthUint8,
+                                      EfiPciWidthUint32,
                                       RomBarOffset + OffsetPcir,
-                                      sizeof (PCI_DATA_STRUCTURE),
+                                      sizeof (PCI_DATA_STRUCTURE) / sizeof (UINT32),
                                       (UINT8 *)RomPcir
                                       );
     //
@@ -567,6 +567,8 @@ ScsiDiskReset (
 
   ScsiDiskDevice = SCSI_DISK_DEV_FROM_BLKIO (This);
 
+  ScsiDiskDevice->LearnedMaxTransferBlocks = 0;
+
   Status = ScsiDiskDevice->ScsiIo->ResetDevice (ScsiDiskDevice->ScsiIo);
 
   if (EFI_ERROR (Status)) {
@@ -951,6 +953,8 @@ ScsiDiskResetEx (
 
   ScsiDiskDevice = SCSI_DISK_DEV_FROM_BLKIO2 (This);
 
+  ScsiDiskDevice->LearnedMaxTransferBlocks = 0;
+
   Status = ScsiDiskDevice->ScsiIo->ResetDevice (ScsiDiskDevice->ScsiIo);
 
   if (EFI_ERROR (Status)) {
@@ -2500,6 +2504,13 @@ ScsiDiskDetectMedia (
     *MediaChange = TRUE;
   }
 
+  if (*MediaChange) {
+    //
+    // The transfer length learned from the old media may not apply.
+    //
+    ScsiDiskDevice->LearnedMaxTransferBlocks = 0;
+  }
+
 EXIT:
   if (TimeoutEvt != NULL) {
     gBS->CloseEvent (TimeoutEvt);
@@ -2670,6 +2681,16 @@ ScsiDiskInquiryDevice (
               (BlockLimits->OptimalTransferLengthGranularity2 << 8) |
               BlockLimits->OptimalTransferLengthGranularity1;
 
+            //
+            // A value of 0 indicates that there is no reported limit on the
+            // transfer length of a single READ or WRITE command.
+            //
+            ScsiDiskDevice->MaxTransferBlocks =
+              ((UINT32)BlockLimits->MaximumTransferLength4 << 24) |
+              (BlockLimits->MaximumTransferLength3 << 16) |
+              (BlockLimits->MaximumTransferLength2 << 8)  |
+              BlockLimits->MaximumTransferLength1;
+
             ScsiDiskDevice->UnmapInfo.MaxLbaCnt =
               (BlockLimits->MaximumUnmapLbaCount4 << 24) |
               (BlockLimits->MaximumUnmapLbaCount3 << 16) |
@@ -3435,6 +3456,44 @@ ParseInquiryData (
   ScsiDiskDevice->BlkIoMedia.RemovableMedia = (BOOLEAN)(!ScsiDiskDevice->FixedDevice);
 }
 
+/**
+  Get the maximum number of blocks that can be transferred by one READ or
+  WRITE command.
+
+  The limit is the maximum transfer length of the command descriptor block,
+  further reduced by the maximum transfer length reported in the Block Limits
+  VPD page, and by the transfer length the SCSI pass thru driver has lowered a
+  previous command to.
+
+  @param  ScsiDiskDevice  The pointer of SCSI_DISK_DEV
+
+  @return The maximum number of blocks for one READ or WRITE command.
+
+**/
+UINT32
+ScsiDiskGetMaxTransferBlocks (
+  IN SCSI_DISK_DEV  *ScsiDiskDevice
+  )
+{
+  UINT32  MaxBlock;
+
+  if (!ScsiDiskDevice->Cdb16Byte) {
+    MaxBlock = 0xFFFF;
+  } else {
+    MaxBlock = 0xFFFFFFFF;
+  }
+
+  if ((ScsiDiskDevice->MaxTransferBlocks != 0) && (ScsiDiskDevice->MaxTransferBlocks < MaxBlock)) {
+    MaxBlock = ScsiDiskDevice->MaxTransferBlocks;
+  }
+
+  if ((ScsiDiskDevice->LearnedMaxTransferBlocks != 0) && (ScsiDiskDevice->LearnedMaxTransferBlocks < MaxBlock)) {
+    MaxBlock = ScsiDiskDevice->LearnedMaxTransferBlocks;
+  }
+
+  return MaxBlock;
+}
+
 /**
   Read sector from SCSI Disk.
 
@@ -3476,11 +3535,7 @@ ScsiDiskReadSectors (
   //
   // limit the data bytes that can be transferred by one Read(10) or Read(16) Command
   //
-  if (!ScsiDiskDevice->Cdb16Byte) {
-    MaxBlock = 0xFFFF;
-  } else {
-    MaxBlock = 0xFFFFFFFF;
-  }
+  MaxBlock = ScsiDiskGetMaxTransferBlocks (ScsiDiskDevice);
 
   PtrBuffer = Buffer;
 
@@ -3580,6 +3635,14 @@ ScsiDiskReadSectors (
         // Account for any rounding down.
         //
         ByteCount = SectorCount * BlockSize;
+        //
+        // Remember a transfer length the pass thru driver rejected as too
+        // big, so that the following commands don't have to be rejected
+        // once before being retried.
+        //
+        if ((Status == EFI_BAD_BUFFER_SIZE) && (SectorCount != 0)) {
+          ScsiDiskDevice->LearnedMaxTransferBlocks = SectorCount;
+        }
       }
     }
 
@@ -3641,11 +3704,7 @@ ScsiDiskWriteSectors (
   //
   // limit the data bytes that can be transferred by one Read(10) or Read(16) Command
   //
-  if (!ScsiDiskDevice->Cdb16Byte) {
-    MaxBlock = 0xFFFF;
-  } else {
-    MaxBlock = 0xFFFFFFFF;
-  }
+  MaxBlock = ScsiDiskGetMaxTransferBlocks (ScsiDiskDevice);
 
   PtrBuffer = Buffer;
 
@@ -3744,6 +3803,14 @@ ScsiDiskWriteSectors (
         // Account for any rounding down.
         //
         ByteCount = SectorCount * BlockSize;
+        //
+        // Remember a transfer length the pass thru driver rejected as too
+        // big, so that the following commands don't have to be rejected
+        // once before being retried.
+        //
+        if ((Status == EFI_BAD_BUFFER_SIZE) && (SectorCount != 0)) {
+          ScsiDiskDevice->LearnedMaxTransferBlocks = SectorCount;
+        }
       }
     }
 
@@ -3825,11 +3892,7 @@ ScsiDiskAsyncReadSectors (
   // Limit the data bytes that can be transferred by one Read(10) or Read(16)
   // Command
   //
-  if (!ScsiDiskDevice->Cdb16Byte) {
-    MaxBlock = 0xFFFF;
-  } else {
-    MaxBlock = 0xFFFFFFFF;
-  }
+  MaxBlock = ScsiDiskGetMaxTransferBlocks (ScsiDiskDevice);
 
   PtrBuffer = Buffer;
 
@@ -4043,11 +4106,7 @@ ScsiDiskAsyncWriteSectors (
   // Limit the data bytes that can be transferred by one Read(10) or Read(16)
   // Command
   //
-  if (!ScsiDiskDevice->Cdb16Byte) {
-    MaxBlock = 0xFFFF;
-  } else {
-    MaxBlock = 0xFFFFFFFF;
-  }
+  MaxBlock = ScsiDiskGetMaxTransferBlocks (ScsiDiskDevice);
 
   PtrBuffer = Buffer;
 
@@ -4256,7 +4315,10 @@ BackOff:
                       SectorCount
                       );
 
-  if ((ReturnStatus == EFI_NOT_READY) || (ReturnStatus == EFI_BAD_BUFFER_SIZE)) {
+  if (ReturnStatus == EFI_BAD_BUFFER_SIZE) {
+    *NeedRetry = TRUE;
+    return EFI_BAD_BUFFER_SIZE;
+  } else if (ReturnStatus == EFI_NOT_READY) {
     *NeedRetry = TRUE;
     return EFI_DEVICE_ERROR;
   } else if ((ReturnStatus == EFI_INVALID_PARAMETER) || (ReturnStatus == EFI_UNSUPPORTED)) {
@@ -4380,7 +4442,10 @@ BackOff:
                       StartLba,
                       SectorCount
                       );
-  if ((ReturnStatus == EFI_NOT_READY) || (ReturnStatus == EFI_BAD_BUFFER_SIZE)) {
+  if (ReturnStatus == EFI_BAD_BUFFER_SIZE) {
+    *NeedRetry = TRUE;
+    return EFI_BAD_BUFFER_SIZE;
+  } else if (ReturnStatus == EFI_NOT_READY) {
     *NeedRetry = TRUE;
     return EFI_DEVICE_ERROR;
   } else if ((ReturnStatus == EFI_INVALID_PARAMETER) || (ReturnStatus == EFI_UNSUPPORTED)) {
@@ -4503,7 +4568,10 @@ BackOff:
                       StartLba,
                       SectorCount
                       );
-  if ((ReturnStatus == EFI_NOT_READY) || (ReturnStatus == EFI_BAD_BUFFER_SIZE)) {
+  if (ReturnStatus == EFI_BAD_BUFFER_SIZE) {
+    *NeedRetry = TRUE;
+    return EFI_BAD_BUFFER_SIZE;
+  } else if (ReturnStatus == EFI_NOT_READY) {
     *NeedRetry = TRUE;
     return EFI_DEVICE_ERROR;
   } else if ((ReturnStatus == EFI_INVALID_PARAMETER) || (ReturnStatus == EFI_UNSUPPORTED)) {
@@ -4627,7 +4695,10 @@ BackOff:
                       StartLba,
                       SectorCount
                       );
-  if ((ReturnStatus == EFI_NOT_READY) || (ReturnStatus == EFI_BAD_BUFFER_SIZE)) {
+  if (ReturnStatus == EFI_BAD_BUFFER_SIZE) {
+    *NeedRetry = TRUE;
+    return EFI_BAD_BUFFER_SIZE;
+  } else if (ReturnStatus == EFI_NOT_READY) {
     *NeedRetry = TRUE;
     return EFI_DEVICE_ERROR;
   } else if ((ReturnStatus == EFI_INVALID_PARAMETER) || (ReturnStatus == EFI_UNSUPPORTED)) {
@@ -85,6 +85,19 @@ typedef struct {
   SCSI_UNMAP_PARAM_INFO                    UnmapInfo;
   BOOLEAN                                  BlockLimitsVpdSupported;
 
+  //
+  // The maximum number of blocks transferred by one READ or WRITE command,
+  // as reported by the Block Limits VPD page, 0 if no limit is reported
+  //
+  UINT32                                   MaxTransferBlocks;
+
+  //
+  // The transfer length the SCSI pass thru driver lowered a READ or WRITE
+  // command to with EFI_BAD_BUFFER_SIZE, 0 if no limit was learned. It is
+  // cleared on reset and on media change.
+  //
+  UINT32                                   LearnedMaxTransferBlocks;
+
   //
   // The flag indicates if 16-byte command can be used
   //
@@ -1050,6 +1063,20 @@ ParseInquiryData (
   IN OUT SCSI_DISK_DEV  *ScsiDiskDevice
   );
 
+/**
+  Get the maximum number of blocks that can be transferred by one READ or
+  WRITE command.
+
+  @param  ScsiDiskDevice  The pointer of SCSI_DISK_DEV
+
+  @return The maximum number of blocks for one READ or WRITE command.
+
+**/
+UINT32
+ScsiDiskGetMaxTransferBlocks (
+  IN SCSI_DISK_DEV  *ScsiDiskDevice
+  );
+
 /**
   Read sector from SCSI Disk.
 
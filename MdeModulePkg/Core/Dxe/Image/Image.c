@@ -681,12 +681,29 @@ CoreLoadPeImage (
       }
     } else {
       if ((Image->ImageContext.ImageAddress >= 0x100000) || Image->ImageContext.RelocationsStripped) {
+        //
+        // An image linked at an aligned address is loaded there as-is, so it
+        // does not need the slack for aligning the image base, and
+        // PeCoffLoaderRelocateImage() will not have to apply any fixup.
+        //
+        if ((Image->ImageContext.ImageAddress & (Image->ImageContext.SectionAlignment - 1)) == 0) {
+          Image->NumberOfPages = EFI_SIZE_TO_PAGES ((UINTN)Image->ImageContext.ImageSize);
+        }
+
         Status = CoreAllocatePages (
                    AllocateAddress,
                    (EFI_MEMORY_TYPE)(Image->ImageContext.ImageCodeMemoryType),
                    Image->NumberOfPages,
                    &Image->ImageContext.ImageAddress
                    );
+        if (EFI_ERROR (Status) && !Image->ImageContext.RelocationsStripped) {
+          DEBUG ((
+            DEBUG_INFO | DEBUG_LOAD,
+            "Link address 0x%lx of image is not available, relocating it\n",
+            Image->ImageContext.ImageAddress
+            ));
+          Image->NumberOfPages = EFI_SIZE_TO_PAGES (Size);
+        }
       }
 
       if (EFI_ERROR (Status) && !Image->ImageContext.RelocationsStripped) {
@@ -455,6 +455,104 @@ FindFileEx (
   return EFI_NOT_FOUND;
 }
 
+/**
+  Build the file name index of a firmware volume.
+
+  The FV is walked once, and the name and offset of every file in it are
+  recorded, so that later lookups by name don't need to walk the FFS file
+  headers and verify their checksums again.
+
+  @param CoreFvHandle    The firmware volume to index.
+
+  @retval EFI_SUCCESS           The index was built.
+  @retval EFI_OUT_OF_RESOURCES  No memory is available for the index.
+
+**/
+EFI_STATUS
+BuildFvFileIndex (
+  IN OUT PEI_CORE_FV_HANDLE  *CoreFvHandle
+  )
+{
+  EFI_STATUS                    Status;
+  EFI_PEI_FILE_HANDLE           FileHandle;
+  PEI_CORE_FV_FILE_INDEX_ENTRY  *FileIndex;
+  UINTN                         FileCount;
+  UINTN                         Index;
+
+  PERF_INMODULE_BEGIN ("FvFileIndex");
+
+  FileCount  = 0;
+  FileHandle = NULL;
+  while (!EFI_ERROR (FindFileEx (CoreFvHandle->FvHandle, NULL, EFI_FV_FILETYPE_ALL, &FileHandle, NULL))) {
+    FileCount++;
+  }
+
+  FileIndex = NULL;
+  if (FileCount != 0) {
+    FileIndex = AllocatePool (sizeof (PEI_CORE_FV_FILE_INDEX_ENTRY) * FileCount);
+    if (FileIndex == NULL) {
+      PERF_INMODULE_END ("FvFileIndex");
+      return EFI_OUT_OF_RESOURCES;
+    }
+  }
+
+  FileHandle = NULL;
+  for (Index = 0; Index < FileCount; Index++) {
+    Status = FindFileEx (CoreFvHandle->FvHandle, NULL, EFI_FV_FILETYPE_ALL, &FileHandle, NULL);
+    ASSERT_EFI_ERROR (Status);
+    CopyGuid (&FileIndex[Index].Name, &((EFI_FFS_FILE_HEADER *)FileHandle)->Name);
+    FileIndex[Index].Offset = (UINT32)((UINTN)FileHandle - (UINTN)CoreFvHandle->FvHandle);
+  }
+
+  CoreFvHandle->FileIndex      = FileIndex;
+  CoreFvHandle->FileIndexCount = FileCount;
+  CoreFvHandle->FileIndexValid = TRUE;
+
+  PERF_INMODULE_END ("FvFileIndex");
+  DEBUG ((DEBUG_INFO, "Indexed %d files in FV at 0x%p\n", (UINT32)FileCount, CoreFvHandle->FvHandle));
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Find a file within a firmware volume by its name, using the file name index
+  of the volume. The index is built on the first lookup.
+
+  @param CoreFvHandle    The firmware volume to search.
+  @param FileName        A pointer to the name of the file to find.
+  @param FileHandle      Upon exit, points to the found file's handle
+                         or NULL if it could not be found.
+
+  @retval EFI_SUCCESS    File was found.
+  @retval EFI_NOT_FOUND  File was not found.
+
+**/
+EFI_STATUS
+FindFileByNameInFv (
+  IN OUT PEI_CORE_FV_HANDLE   *CoreFvHandle,
+  IN     CONST EFI_GUID       *FileName,
+  OUT    EFI_PEI_FILE_HANDLE  *FileHandle
+  )
+{
+  UINTN  Index;
+
+  if (!CoreFvHandle->FileIndexValid) {
+    if (EFI_ERROR (BuildFvFileIndex (CoreFvHandle))) {
+      return FindFileEx (CoreFvHandle->FvHandle, FileName, 0, FileHandle, NULL);
+    }
+  }
+
+  for (Index = 0; Index < CoreFvHandle->FileIndexCount; Index++) {
+    if (CompareGuid (&CoreFvHandle->FileIndex[Index].Name, FileName)) {
+      *FileHandle = (EFI_PEI_FILE_HANDLE)((UINT8 *)CoreFvHandle->FvHandle + CoreFvHandle->FileIndex[Index].Offset);
+      return EFI_SUCCESS;
+    }
+  }
+
+  *FileHandle = NULL;
+  return EFI_NOT_FOUND;
+}
+
 /**
   Initialize PeiCore FV List.
 
@@ -1727,16 +1825,23 @@ PeiFfsFvPpiFindFileByName (
   OUT EFI_PEI_FILE_HANDLE                 *FileHandle
   )
 {
-  EFI_STATUS         Status;
-  PEI_CORE_INSTANCE  *PrivateData;
-  UINTN              Index;
+  EFI_STATUS          Status;
+  PEI_CORE_INSTANCE   *PrivateData;
+  PEI_CORE_FV_HANDLE  *CoreFvHandle;
+  UINTN               Index;
 
   if ((FvHandle == NULL) || (FileName == NULL) || (FileHandle == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
 
   if (*FvHandle != NULL) {
-    Status = FindFileEx (*FvHandle, FileName, 0, FileHandle, NULL);
+    CoreFvHandle = FvHandleToCoreHandle (*FvHandle);
+    if (CoreFvHandle != NULL) {
+      Status = FindFileByNameInFv (CoreFvHandle, FileName, FileHandle);
+    } else {
+      Status = FindFileEx (*FvHandle, FileName, 0, FileHandle, NULL);
+    }
+
     if (Status == EFI_NOT_FOUND) {
       *FileHandle = NULL;
     }
@@ -1752,7 +1857,7 @@ PeiFfsFvPpiFindFileByName (
       // Only search the FV which is associated with a EFI_PEI_FIRMWARE_VOLUME_PPI instance.
       //
       if (PrivateData->Fv[Index].FvPpi != NULL) {
-        Status = FindFileEx (PrivateData->Fv[Index].FvHandle, FileName, 0, FileHandle, NULL);
+        Status = FindFileByNameInFv (&PrivateData->Fv[Index], FileName, FileHandle);
         if (!EFI_ERROR (Status)) {
           *FvHandle = PrivateData->Fv[Index].FvHandle;
           break;
@@ -300,6 +300,40 @@ FindFileEx (
   IN OUT    EFI_PEI_FILE_HANDLE  *AprioriFile  OPTIONAL
   );
 
+/**
+  Build the file name index of a firmware volume.
+
+  @param CoreFvHandle    The firmware volume to index.
+
+  @retval EFI_SUCCESS           The index was built.
+  @retval EFI_OUT_OF_RESOURCES  No memory is available for the index.
+
+**/
+EFI_STATUS
+BuildFvFileIndex (
+  IN OUT PEI_CORE_FV_HANDLE  *CoreFvHandle
+  );
+
+/**
+  Find a file within a firmware volume by its name, using the file name index
+  of the volume. The index is built on the first lookup.
+
+  @param CoreFvHandle    The firmware volume to search.
+  @param FileName        A pointer to the name of the file to find.
+  @param FileHandle      Upon exit, points to the found file's handle
+                         or NULL if it could not be found.
+
+  @retval EFI_SUCCESS    File was found.
+  @retval EFI_NOT_FOUND  File was not found.
+
+**/
+EFI_STATUS
+FindFileByNameInFv (
+  IN OUT PEI_CORE_FV_HANDLE   *CoreFvHandle,
+  IN     CONST EFI_GUID       *FileName,
+  OUT    EFI_PEI_FILE_HANDLE  *FileHandle
+  );
+
 /**
   Report the information for a newly discovered FV in an unknown format.
 
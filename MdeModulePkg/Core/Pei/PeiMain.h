@@ -131,6 +131,15 @@ typedef struct {
 //
 #define FV_GROWTH_STEP  8
 
+///
+/// Entry of the file name index of a firmware volume. The offset is relative
+/// to the FV header, so the index stays valid when the FV is migrated.
+///
+typedef struct {
+  EFI_GUID    Name;
+  UINT32      Offset;
+} PEI_CORE_FV_FILE_INDEX_ENTRY;
+
 typedef struct {
   EFI_FIRMWARE_VOLUME_HEADER     *FvHeader;
   EFI_PEI_FIRMWARE_VOLUME_PPI    *FvPpi;
@@ -146,6 +155,13 @@ typedef struct {
   EFI_PEI_FILE_HANDLE            *FvFileHandles;
   BOOLEAN                        ScanFv;
   UINT32                         AuthenticationStatus;
+  //
+  // Pointer to the buffer with the FileIndexCount number of Entries, built by
+  // the first lookup of a file by name in this FV.
+  //
+  PEI_CORE_FV_FILE_INDEX_ENTRY   *FileIndex;
+  UINTN                          FileIndexCount;
+  BOOLEAN                        FileIndexValid;
 } PEI_CORE_FV_HANDLE;
 
 typedef struct {
@@ -0,0 +1,63 @@
+/** @file
+  Debug log buffer configuration table definition.
+
+  The debug log buffer is a ring of formatted debug messages shared by all the
+  DXE modules linked with DxeDebugLibBufferedSerialPort. Messages are appended
+  to the ring when DEBUG() is called and written to the serial port later, from
+  a timer event or at ExitBootServices(). Drained bytes are left in place, so
+  the ring always holds the most recent output of the boot services phase.
+
+  The header is followed by Size bytes of ring data. The byte at running offset
+  N is stored at Data[N % Size]. The valid log is the range
+  [MAX (WriteOffset, Size) - Size, WriteOffset).
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _DEBUG_LOG_BUFFER_H_
+#define _DEBUG_LOG_BUFFER_H_
+
+#define EDKII_DEBUG_LOG_BUFFER_GUID \
+  { \
+    0x3c6f2a0b, 0x9e41, 0x4d57, { 0xb8, 0x1d, 0x72, 0xe5, 0x0a, 0x94, 0xc3, 0x6e } \
+  }
+
+#define EDKII_DEBUG_LOG_BUFFER_SIGNATURE  SIGNATURE_32 ('D','L','O','G')
+#define EDKII_DEBUG_LOG_BUFFER_REVISION   0x0001
+
+///
+/// A module is writing ring data to the serial port.
+///
+#define EDKII_DEBUG_LOG_BUFFER_DRAINING  BIT0
+///
+/// A module owns the periodic drain timer.
+///
+#define EDKII_DEBUG_LOG_BUFFER_DRAIN_TIMER  BIT1
+
+typedef struct {
+  UINT32    Signature;
+  UINT16    HeaderLength;
+  UINT16    Revision;
+  ///
+  /// Size in bytes of the ring data following the header.
+  ///
+  UINT32    Size;
+  ///
+  /// EDKII_DEBUG_LOG_BUFFER_* flags, only changed with interrupts disabled.
+  ///
+  UINT32    Flags;
+  ///
+  /// Running count of bytes written to the ring.
+  ///
+  UINT64    WriteOffset;
+  ///
+  /// Running count of bytes drained to the serial port.
+  ///
+  UINT64    ReadOffset;
+  // UINT8  Data[Size];
+} EDKII_DEBUG_LOG_BUFFER_HEADER;
+
+extern EFI_GUID  gEdkiiDebugLogBufferGuid;
+
+#endif
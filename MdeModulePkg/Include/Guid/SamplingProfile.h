@@ -0,0 +1,56 @@
+/** @file
+  Sampling profile configuration table definition.
+
+  The sampling profile is collected by SamplingProfilerDxe, which records the
+  instruction pointer interrupted by every system timer tick and attributes it
+  to the loaded image containing it. The profile is installed as a configuration
+  table at ReadyToBoot.
+
+  The header is followed by a NULL-terminated ASCII profile in the folded stack
+  format consumed by flame graph tools, one line per sampled location:
+    <ImageName>;<ImageName>+0x<Offset> <SampleCount>
+  Offset is relative to the image base, so it can be symbolized with the
+  debug information of the image.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _SAMPLING_PROFILE_H_
+#define _SAMPLING_PROFILE_H_
+
+#define EDKII_SAMPLING_PROFILE_GUID \
+  { \
+    0x5e4a1c92, 0x7d3b, 0x4f0e, { 0xa6, 0x28, 0xc1, 0x3f, 0x9b, 0x57, 0x0d, 0xe4 } \
+  }
+
+#define EDKII_SAMPLING_PROFILE_SIGNATURE  SIGNATURE_32 ('S','P','R','F')
+#define EDKII_SAMPLING_PROFILE_REVISION   0x0001
+
+typedef struct {
+  UINT32    Signature;
+  UINT16    HeaderLength;
+  UINT16    Revision;
+  ///
+  /// Sampling period in 100 ns units, 0 if unknown.
+  ///
+  UINT64    SamplePeriod;
+  ///
+  /// Number of samples recorded in the profile.
+  ///
+  UINT64    SampleCount;
+  ///
+  /// Number of samples dropped because the sample buffer was full.
+  ///
+  UINT64    DroppedSampleCount;
+  ///
+  /// Size in bytes of the folded profile following the header, including the NULL terminator.
+  ///
+  UINT32    ProfileSize;
+  UINT32    Reserved;
+  // CHAR8  Profile[];
+} EDKII_SAMPLING_PROFILE_HEADER;
+
+extern EFI_GUID  gEdkiiSamplingProfileGuid;
+
+#endif
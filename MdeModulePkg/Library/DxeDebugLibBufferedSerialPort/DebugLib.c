@@ -0,0 +1,737 @@
+/** @file
+  Buffered Debug library instance based on Serial Port library.
+
+  DEBUG() messages are formatted into a ring buffer in memory instead of being
+  written to the serial port synchronously. The ring is shared by all the DXE
+  modules linked with this instance and is installed as the
+  gEdkiiDebugLogBufferGuid configuration table by the first one. One module at
+  a time owns a periodic timer event that drains the ring to the serial port.
+  When the owner is unloaded, the next module constructed takes the timer
+  over. Every module drains the ring at ExitBootServices(), before an ASSERT()
+  message and whenever the ring is too full to hold a new message.
+
+  Copyright (c) 2006 - 2019, Intel Corporation. All rights reserved.<BR>
+  Copyright (c) 2018, Linaro, Ltd. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Guid/DebugLogBuffer.h>
+#include <Library/DebugLib.h>
+#include <Library/DebugPrintErrorLevelLib.h>
+#include <Library/BaseLib.h>
+#include <Library/PrintLib.h>
+#include <Library/PcdLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/SerialPortLib.h>
+
+//
+// Define the maximum debug and assert message length that this library supports
+//
+#define MAX_DEBUG_MESSAGE_LENGTH  0x100
+
+//
+// Number of bytes moved out of the ring with interrupts disabled at a time
+//
+#define DEBUG_LOG_DRAIN_CHUNK_SIZE  0x40
+
+//
+// Period of the drain timer, in 100 ns units (50 ms)
+//
+#define DEBUG_LOG_DRAIN_PERIOD  500000
+
+STATIC EFI_EVENT                      mEfiExitBootServicesEvent;
+STATIC EFI_EVENT                      mDebugLogDrainEvent;
+STATIC BOOLEAN                        mEfiAtRuntime = FALSE;
+STATIC EDKII_DEBUG_LOG_BUFFER_HEADER  *mDebugLog;
+
+//
+// VA_LIST can not initialize to NULL for all compiler, so we use this to
+// indicate a null VA_LIST
+//
+VA_LIST  mVaListNull;
+
+/**
+  Write all pending bytes of the debug log buffer to the serial port.
+
+  The bytes are moved out of the ring in small chunks with interrupts disabled,
+  and written to the serial port with interrupts restored, so a DEBUG() message
+  from a higher TPL is never delayed by the serial port.
+
+  Only one drain runs at a time. A drain nested from the timer event or from a
+  DEBUG() at a higher TPL returns at once and leaves the pending bytes to the
+  drain it interrupted, which runs until the ring is empty. This keeps the
+  chunks in order on the serial port.
+
+**/
+STATIC
+VOID
+DebugLogBufferDrain (
+  VOID
+  )
+{
+  UINT8    Chunk[DEBUG_LOG_DRAIN_CHUNK_SIZE];
+  UINT8    *Data;
+  UINTN    Length;
+  UINTN    Start;
+  UINTN    Head;
+  BOOLEAN  InterruptState;
+
+  if (mDebugLog == NULL) {
+    return;
+  }
+
+  InterruptState = SaveAndDisableInterrupts ();
+  if ((mDebugLog->Flags & EDKII_DEBUG_LOG_BUFFER_DRAINING) != 0) {
+    SetInterruptState (InterruptState);
+    return;
+  }
+
+  mDebugLog->Flags |= EDKII_DEBUG_LOG_BUFFER_DRAINING;
+  SetInterruptState (InterruptState);
+
+  Data = (UINT8 *)(mDebugLog + 1);
+  do {
+    InterruptState = SaveAndDisableInterrupts ();
+    Length         = (UINTN)MIN (mDebugLog->WriteOffset - mDebugLog->ReadOffset, sizeof (Chunk));
+    if (Length != 0) {
+      Start = (UINTN)ModU64x32 (mDebugLog->ReadOffset, mDebugLog->Size);
+      Head  = MIN (Length, mDebugLog->Size - Start);
+      CopyMem (Chunk, Data + Start, Head);
+      CopyMem (Chunk + Head, Data, Length - Head);
+      mDebugLog->ReadOffset += Length;
+    } else {
+      //
+      // Release the drain in the same critical section that found the ring
+      // empty, so that no byte appended after this point is left behind.
+      //
+      mDebugLog->Flags &= ~EDKII_DEBUG_LOG_BUFFER_DRAINING;
+    }
+
+    SetInterruptState (InterruptState);
+
+    if (Length != 0) {
+      SerialPortWrite (Chunk, Length);
+    }
+  } while (Length != 0);
+}
+
+/**
+  Append a formatted message to the debug log buffer.
+
+  If the ring cannot hold the message, it is drained first. If it still cannot,
+  the message is written to the serial port directly.
+
+  @param[in]  Buffer  The message to append.
+  @param[in]  Length  The length of the message in bytes.
+
+**/
+STATIC
+VOID
+DebugLogBufferWrite (
+  IN CONST UINT8  *Buffer,
+  IN UINTN        Length
+  )
+{
+  UINT8    *Data;
+  UINTN    Start;
+  UINTN    Head;
+  BOOLEAN  InterruptState;
+
+  if (mDebugLog == NULL) {
+    SerialPortWrite ((UINT8 *)Buffer, Length);
+    return;
+  }
+
+  if (mDebugLog->WriteOffset - mDebugLog->ReadOffset + Length > mDebugLog->Size) {
+    DebugLogBufferDrain ();
+  }
+
+  Data           = (UINT8 *)(mDebugLog + 1);
+  InterruptState = SaveAndDisableInterrupts ();
+  if (mDebugLog->WriteOffset - mDebugLog->ReadOffset + Length > mDebugLog->Size) {
+    SetInterruptState (InterruptState);
+    SerialPortWrite ((UINT8 *)Buffer, Length);
+    return;
+  }
+
+  Start = (UINTN)ModU64x32 (mDebugLog->WriteOffset, mDebugLog->Size);
+  Head  = MIN (Length, mDebugLog->Size - Start);
+  CopyMem (Data + Start, Buffer, Head);
+  CopyMem (Data, Buffer + Head, Length - Head);
+  mDebugLog->WriteOffset += Length;
+  SetInterruptState (InterruptState);
+}
+
+/**
+  Drain the debug log buffer to the serial port.
+
+  @param[in]  Event   The Event that is being processed.
+  @param[in]  Context The Event Context.
+
+**/
+STATIC
+VOID
+EFIAPI
+DebugLogDrainEvent (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  DebugLogBufferDrain ();
+}
+
+/**
+  Drain the debug log buffer and set AtRuntime flag as TRUE after
+  ExitBootServices.
+
+  @param[in]  Event   The Event that is being processed.
+  @param[in]  Context The Event Context.
+
+**/
+STATIC
+VOID
+EFIAPI
+ExitBootServicesEvent (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  DebugLogBufferDrain ();
+  mEfiAtRuntime = TRUE;
+}
+
+/**
+  Locate the debug log buffer, or create it and install it as a configuration
+  table if this is the first module using it.
+
+  @param[in]  SystemTable   A pointer to the EFI System Table.
+
+**/
+STATIC
+VOID
+DebugLogBufferInitialize (
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS            Status;
+  EFI_PHYSICAL_ADDRESS  Address;
+  UINTN                 Pages;
+  UINTN                 Index;
+
+  for (Index = 0; Index < SystemTable->NumberOfTableEntries; Index++) {
+    if (CompareGuid (&gEdkiiDebugLogBufferGuid, &SystemTable->ConfigurationTable[Index].VendorGuid)) {
+      mDebugLog = SystemTable->ConfigurationTable[Index].VendorTable;
+      return;
+    }
+  }
+
+  if (PcdGet32 (PcdDebugLogBufferSize) == 0) {
+    return;
+  }
+
+  Pages  = EFI_SIZE_TO_PAGES (sizeof (EDKII_DEBUG_LOG_BUFFER_HEADER) + PcdGet32 (PcdDebugLogBufferSize));
+  Status = SystemTable->BootServices->AllocatePages (
+                                        AllocateAnyPages,
+                                        EfiRuntimeServicesData,
+                                        Pages,
+                                        &Address
+                                        );
+  if (EFI_ERROR (Status)) {
+    return;
+  }
+
+  mDebugLog = (EDKII_DEBUG_LOG_BUFFER_HEADER *)(UINTN)Address;
+  ZeroMem (mDebugLog, sizeof (EDKII_DEBUG_LOG_BUFFER_HEADER));
+  mDebugLog->Signature    = EDKII_DEBUG_LOG_BUFFER_SIGNATURE;
+  mDebugLog->HeaderLength = sizeof (EDKII_DEBUG_LOG_BUFFER_HEADER);
+  mDebugLog->Revision     = EDKII_DEBUG_LOG_BUFFER_REVISION;
+  mDebugLog->Size         = (UINT32)(EFI_PAGES_TO_SIZE (Pages) - sizeof (EDKII_DEBUG_LOG_BUFFER_HEADER));
+
+  Status = SystemTable->BootServices->InstallConfigurationTable (&gEdkiiDebugLogBufferGuid, mDebugLog);
+  if (EFI_ERROR (Status)) {
+    SystemTable->BootServices->FreePages (Address, Pages);
+    mDebugLog = NULL;
+  }
+}
+
+/**
+  Take over the periodic drain of the debug log buffer if no other module
+  owns it, either because the ring was just created or because the previous
+  owner was unloaded.
+
+  @param[in]  SystemTable   A pointer to the EFI System Table.
+
+**/
+STATIC
+VOID
+DebugLogDrainTimerClaim (
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS  Status;
+  BOOLEAN     InterruptState;
+
+  if (mDebugLog == NULL) {
+    return;
+  }
+
+  InterruptState = SaveAndDisableInterrupts ();
+  if ((mDebugLog->Flags & EDKII_DEBUG_LOG_BUFFER_DRAIN_TIMER) != 0) {
+    SetInterruptState (InterruptState);
+    return;
+  }
+
+  mDebugLog->Flags |= EDKII_DEBUG_LOG_BUFFER_DRAIN_TIMER;
+  SetInterruptState (InterruptState);
+
+  Status = SystemTable->BootServices->CreateEvent (
+                                        EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                                        TPL_CALLBACK,
+                                        DebugLogDrainEvent,
+                                        NULL,
+                                        &mDebugLogDrainEvent
+                                        );
+  if (!EFI_ERROR (Status)) {
+    Status = SystemTable->BootServices->SetTimer (mDebugLogDrainEvent, TimerPeriodic, DEBUG_LOG_DRAIN_PERIOD);
+    if (EFI_ERROR (Status)) {
+      SystemTable->BootServices->CloseEvent (mDebugLogDrainEvent);
+    }
+  }
+
+  if (EFI_ERROR (Status)) {
+    mDebugLogDrainEvent = NULL;
+
+    InterruptState    = SaveAndDisableInterrupts ();
+    mDebugLog->Flags &= ~EDKII_DEBUG_LOG_BUFFER_DRAIN_TIMER;
+    SetInterruptState (InterruptState);
+  }
+}
+
+/**
+  Stop the periodic drain of the debug log buffer if this module owns it, so
+  that the next module constructed can take it over.
+
+  @param[in]  SystemTable   A pointer to the EFI System Table.
+
+**/
+STATIC
+VOID
+DebugLogDrainTimerRelease (
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  BOOLEAN  InterruptState;
+
+  if (mDebugLogDrainEvent == NULL) {
+    return;
+  }
+
+  SystemTable->BootServices->CloseEvent (mDebugLogDrainEvent);
+  mDebugLogDrainEvent = NULL;
+
+  InterruptState    = SaveAndDisableInterrupts ();
+  mDebugLog->Flags &= ~EDKII_DEBUG_LOG_BUFFER_DRAIN_TIMER;
+  SetInterruptState (InterruptState);
+}
+
+/**
+  The constructor function to initialize the Serial Port library and the debug
+  log buffer, and register a callback for the ExitBootServices event.
+
+  @param[in]  ImageHandle   The firmware allocated handle for the EFI image.
+  @param[in]  SystemTable   A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS   The operation completed successfully.
+  @retval other         Either the serial port failed to initialize or the
+                        ExitBootServices event callback registration failed.
+**/
+EFI_STATUS
+EFIAPI
+DxeDebugLibBufferedSerialPortConstructor (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = SerialPortInitialize ();
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  DebugLogBufferInitialize (SystemTable);
+  DebugLogDrainTimerClaim (SystemTable);
+
+  return SystemTable->BootServices->CreateEvent (
+                                      EVT_SIGNAL_EXIT_BOOT_SERVICES,
+                                      TPL_NOTIFY,
+                                      ExitBootServicesEvent,
+                                      NULL,
+                                      &mEfiExitBootServicesEvent
+                                      );
+}
+
+/**
+  Drain the debug log buffer and free the events of this module before it is
+  unloaded. The ring itself is left in place for the other modules, and the
+  periodic drain is handed over to the next module constructed.
+
+  @param[in]  ImageHandle   The firmware allocated handle for the EFI image.
+  @param[in]  SystemTable   A pointer to the EFI System Table.
+
+  @retval     EFI_SUCCESS       The library was shut down successfully.
+  @retval     EFI_UNSUPPORTED   The library was not initialized.
+**/
+EFI_STATUS
+EFIAPI
+DxeDebugLibBufferedSerialPortDestructor (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  DebugLogDrainTimerRelease (SystemTable);
+  DebugLogBufferDrain ();
+
+  return SystemTable->BootServices->CloseEvent (mEfiExitBootServicesEvent);
+}
+
+/**
+  Prints a debug message to the debug output device if the specified error level is enabled.
+
+  If any bit in ErrorLevel is also set in DebugPrintErrorLevelLib function
+  GetDebugPrintErrorLevel (), then print the message specified by Format and the
+  associated variable argument list to the debug output device.
+
+  If Format is NULL, then ASSERT().
+
+  @param  ErrorLevel  The error level of the debug message.
+  @param  Format      Format string for the debug message to print.
+  @param  ...         Variable argument list whose contents are accessed
+                      based on the format string specified by Format.
+
+**/
+VOID
+EFIAPI
+DebugPrint (
+  IN  UINTN        ErrorLevel,
+  IN  CONST CHAR8  *Format,
+  ...
+  )
+{
+  VA_LIST  Marker;
+
+  VA_START (Marker, Format);
+  DebugVPrint (ErrorLevel, Format, Marker);
+  VA_END (Marker);
+}
+
+/**
+  Prints a debug message to the debug output device if the specified
+  error level is enabled base on Null-terminated format string and a
+  VA_LIST argument list or a BASE_LIST argument list.
+
+  The message is formatted immediately, because the arguments may refer to
+  memory that does not outlive the call, and appended to the debug log buffer.
+
+  If any bit in ErrorLevel is also set in DebugPrintErrorLevelLib function
+  GetDebugPrintErrorLevel (), then print the message specified by Format and
+  the associated variable argument list to the debug output device.
+
+  If Format is NULL, then ASSERT().
+
+  @param  ErrorLevel      The error level of the debug message.
+  @param  Format          Format string for the debug message to print.
+  @param  VaListMarker    VA_LIST marker for the variable argument list.
+  @param  BaseListMarker  BASE_LIST marker for the variable argument list.
+
+**/
+VOID
+DebugPrintMarker (
+  IN  UINTN        ErrorLevel,
+  IN  CONST CHAR8  *Format,
+  IN  VA_LIST      VaListMarker,
+  IN  BASE_LIST    BaseListMarker
+  )
+{
+  CHAR8  Buffer[MAX_DEBUG_MESSAGE_LENGTH];
+  UINTN  Length;
+
+  if (mEfiAtRuntime) {
+    return;
+  }
+
+  //
+  // If Format is NULL, then ASSERT().
+  //
+  ASSERT (Format != NULL);
+
+  //
+  // Check driver debug mask value and global mask
+  //
+  if ((ErrorLevel & GetDebugPrintErrorLevel ()) == 0) {
+    return;
+  }
+
+  //
+  // Convert the DEBUG() message to an ASCII String
+  //
+  if (BaseListMarker == NULL) {
+    Length = AsciiVSPrint (Buffer, sizeof (Buffer), Format, VaListMarker);
+  } else {
+    Length = AsciiBSPrint (Buffer, sizeof (Buffer), Format, BaseListMarker);
+  }
+
+  //
+  // Queue the print string for the Serial Port
+  //
+  DebugLogBufferWrite ((UINT8 *)Buffer, Length);
+}
+
+/**
+  Prints a debug message to the debug output device if the specified
+  error level is enabled.
+
+  If any bit in ErrorLevel is also set in DebugPrintErrorLevelLib function
+  GetDebugPrintErrorLevel (), then print the message specified by Format and
+  the associated variable argument list to the debug output device.
+
+  If Format is NULL, then ASSERT().
+
+  @param  ErrorLevel    The error level of the debug message.
+  @param  Format        Format string for the debug message to print.
+  @param  VaListMarker  VA_LIST marker for the variable argument list.
+
+**/
+VOID
+EFIAPI
+DebugVPrint (
+  IN  UINTN        ErrorLevel,
+  IN  CONST CHAR8  *Format,
+  IN  VA_LIST      VaListMarker
+  )
+{
+  DebugPrintMarker (ErrorLevel, Format, VaListMarker, NULL);
+}
+
+/**
+  Prints a debug message to the debug output device if the specified
+  error level is enabled.
+  This function use BASE_LIST which would provide a more compatible
+  service than VA_LIST.
+
+  If any bit in ErrorLevel is also set in DebugPrintErrorLevelLib function
+  GetDebugPrintErrorLevel (), then print the message specified by Format and
+  the associated variable argument list to the debug output device.
+
+  If Format is NULL, then ASSERT().
+
+  @param  ErrorLevel      The error level of the debug message.
+  @param  Format          Format string for the debug message to print.
+  @param  BaseListMarker  BASE_LIST marker for the variable argument list.
+
+**/
+VOID
+EFIAPI
+DebugBPrint (
+  IN  UINTN        ErrorLevel,
+  IN  CONST CHAR8  *Format,
+  IN  BASE_LIST    BaseListMarker
+  )
+{
+  DebugPrintMarker (ErrorLevel, Format, mVaListNull, BaseListMarker);
+}
+
+/**
+  Prints an assert message containing a filename, line number, and description.
+  This may be followed by a breakpoint or a dead loop.
+
+  Print a message of the form "ASSERT <FileName>(<LineNumber>): <Description>\n"
+  to the debug output device.  If DEBUG_PROPERTY_ASSERT_BREAKPOINT_ENABLED bit of
+  PcdDebugProperyMask is set then CpuBreakpoint() is called. Otherwise, if
+  DEBUG_PROPERTY_ASSERT_DEADLOOP_ENABLED bit of PcdDebugProperyMask is set then
+  CpuDeadLoop() is called.  If neither of these bits are set, then this function
+  returns immediately after the message is printed to the debug output device.
+  DebugAssert() must actively prevent recursion.  If DebugAssert() is called while
+  processing another DebugAssert(), then DebugAssert() must return immediately.
+
+  The debug log buffer is drained and the assert message is written to the
+  serial port directly, so that it is visible before the breakpoint or dead loop.
+
+  If FileName is NULL, then a <FileName> string of "(NULL) Filename" is printed.
+  If Description is NULL, then a <Description> string of "(NULL) Description" is printed.
+
+  @param  FileName     The pointer to the name of the source file that generated the assert condition.
+  @param  LineNumber   The line number in the source file that generated the assert condition
+  @param  Description  The pointer to the description of the assert condition.
+
+**/
+VOID
+EFIAPI
+DebugAssert (
+  IN CONST CHAR8  *FileName,
+  IN UINTN        LineNumber,
+  IN CONST CHAR8  *Description
+  )
+{
+  CHAR8  Buffer[MAX_DEBUG_MESSAGE_LENGTH];
+
+  //
+  // Generate the ASSERT() message in Ascii format
+  //
+  AsciiSPrint (
+    Buffer,
+    sizeof (Buffer),
+    "ASSERT [%a] %a(%d): %a\n",
+    gEfiCallerBaseName,
+    FileName,
+    LineNumber,
+    Description
+    );
+
+  if (!mEfiAtRuntime) {
+    //
+    // Flush the pending messages, then send the print string to the Serial Port
+    //
+    DebugLogBufferDrain ();
+    SerialPortWrite ((UINT8 *)Buffer, AsciiStrLen (Buffer));
+  }
+
+  //
+  // Generate a Breakpoint, DeadLoop, or NOP based on PCD settings
+  //
+  if ((PcdGet8 (PcdDebugPropertyMask) & DEBUG_PROPERTY_ASSERT_BREAKPOINT_ENABLED) != 0) {
+    CpuBreakpoint ();
+  } else if ((PcdGet8 (PcdDebugPropertyMask) & DEBUG_PROPERTY_ASSERT_DEADLOOP_ENABLED) != 0) {
+    CpuDeadLoop ();
+  }
+}
+
+/**
+  Fills a target buffer with PcdDebugClearMemoryValue, and returns the target buffer.
+
+  This function fills Length bytes of Buffer with the value specified by
+  PcdDebugClearMemoryValue, and returns Buffer.
+
+  If Buffer is NULL, then ASSERT().
+  If Length is greater than (MAX_ADDRESS - Buffer + 1), then ASSERT().
+
+  @param   Buffer  The pointer to the target buffer to be filled with PcdDebugClearMemoryValue.
+  @param   Length  The number of bytes in Buffer to fill with zeros PcdDebugClearMemoryValue.
+
+  @return  Buffer  The pointer to the target buffer filled with PcdDebugClearMemoryValue.
+
+**/
+VOID *
+EFIAPI
+DebugClearMemory (
+  OUT VOID  *Buffer,
+  IN UINTN  Length
+  )
+{
+  //
+  // If Buffer is NULL, then ASSERT().
+  //
+  ASSERT (Buffer != NULL);
+
+  //
+  // SetMem() checks for the the ASSERT() condition on Length and returns Buffer
+  //
+  return SetMem (Buffer, Length, PcdGet8 (PcdDebugClearMemoryValue));
+}
+
+/**
+  Returns TRUE if ASSERT() macros are enabled.
+
+  This function returns TRUE if the DEBUG_PROPERTY_DEBUG_ASSERT_ENABLED bit of
+  PcdDebugProperyMask is set.  Otherwise FALSE is returned.
+
+  @retval  TRUE    The DEBUG_PROPERTY_DEBUG_ASSERT_ENABLED bit of PcdDebugProperyMask is set.
+  @retval  FALSE   The DEBUG_PROPERTY_DEBUG_ASSERT_ENABLED bit of PcdDebugProperyMask is clear.
+
+**/
+BOOLEAN
+EFIAPI
+DebugAssertEnabled (
+  VOID
+  )
+{
+  return (BOOLEAN)((PcdGet8 (PcdDebugPropertyMask) & DEBUG_PROPERTY_DEBUG_ASSERT_ENABLED) != 0);
+}
+
+/**
+  Returns TRUE if DEBUG() macros are enabled.
+
+  This function returns TRUE if the DEBUG_PROPERTY_DEBUG_PRINT_ENABLED bit of
+  PcdDebugProperyMask is set.  Otherwise FALSE is returned.
+
+  @retval  TRUE    The DEBUG_PROPERTY_DEBUG_PRINT_ENABLED bit of PcdDebugProperyMask is set.
+  @retval  FALSE   The DEBUG_PROPERTY_DEBUG_PRINT_ENABLED bit of PcdDebugProperyMask is clear.
+
+**/
+BOOLEAN
+EFIAPI
+DebugPrintEnabled (
+  VOID
+  )
+{
+  return (BOOLEAN)((PcdGet8 (PcdDebugPropertyMask) & DEBUG_PROPERTY_DEBUG_PRINT_ENABLED) != 0);
+}
+
+/**
+  Returns TRUE if DEBUG_CODE() macros are enabled.
+
+  This function returns TRUE if the DEBUG_PROPERTY_DEBUG_CODE_ENABLED bit of
+  PcdDebugProperyMask is set.  Otherwise FALSE is returned.
+
+  @retval  TRUE    The DEBUG_PROPERTY_DEBUG_CODE_ENABLED bit of PcdDebugProperyMask is set.
+  @retval  FALSE   The DEBUG_PROPERTY_DEBUG_CODE_ENABLED bit of PcdDebugProperyMask is clear.
+
+**/
+BOOLEAN
+EFIAPI
+DebugCodeEnabled (
+  VOID
+  )
+{
+  return (BOOLEAN)((PcdGet8 (PcdDebugPropertyMask) & DEBUG_PROPERTY_DEBUG_CODE_ENABLED) != 0);
+}
+
+/**
+  Returns TRUE if DEBUG_CLEAR_MEMORY() macro is enabled.
+
+  This function returns TRUE if the DEBUG_PROPERTY_CLEAR_MEMORY_ENABLED bit of
+  PcdDebugProperyMask is set.  Otherwise FALSE is returned.
+
+  @retval  TRUE    The DEBUG_PROPERTY_CLEAR_MEMORY_ENABLED bit of PcdDebugProperyMask is set.
+  @retval  FALSE   The DEBUG_PROPERTY_CLEAR_MEMORY_ENABLED bit of PcdDebugProperyMask is clear.
+
+**/
+BOOLEAN
+EFIAPI
+DebugClearMemoryEnabled (
+  VOID
+  )
+{
+  return (BOOLEAN)((PcdGet8 (PcdDebugPropertyMask) & DEBUG_PROPERTY_CLEAR_MEMORY_ENABLED) != 0);
+}
+
+/**
+  Returns TRUE if any one of the bit is set both in ErrorLevel and PcdFixedDebugPrintErrorLevel.
+
+  This function compares the bit mask of ErrorLevel and PcdFixedDebugPrintErrorLevel.
+
+  @retval  TRUE    Current ErrorLevel is supported.
+  @retval  FALSE   Current ErrorLevel is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+DebugPrintLevelEnabled (
+  IN  CONST UINTN  ErrorLevel
+  )
+{
+  return (BOOLEAN)((ErrorLevel & PcdGet32 (PcdFixedDebugPrintErrorLevel)) != 0);
+}
@@ -425,7 +425,16 @@ FrameBufferBltLibVideoToBltBuffer (
 
     CopyMem (Destination, Source, WidthInBytes);
 
-    if (Configure->PixelFormat != PixelBlueGreenRedReserved8BitPerColor) {
+    if (Configure->PixelFormat == PixelRedGreenBlueReserved8BitPerColor) {
+      //
+      // Only the red and blue bytes need to be swapped.
+      //
+      Blt = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)((UINT8 *)BltBuffer + (DstY * Delta) + (DestinationX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)));
+      for (IndexX = 0; IndexX < Width; IndexX++) {
+        Uint32                  = ((UINT32 *)Configure->LineBuffer)[IndexX];
+        ((UINT32 *)Blt)[IndexX] = (Uint32 & 0x0000ff00) | ((Uint32 & 0xff) << 16) | ((Uint32 >> 16) & 0xff);
+      }
+    } else if (Configure->PixelFormat != PixelBlueGreenRedReserved8BitPerColor) {
       for (IndexX = 0; IndexX < Width; IndexX++) {
         Blt = (EFI_GRAPHICS_OUTPUT_BLT_PIXEL *)
               ((UINT8 *)BltBuffer + (DstY * Delta) +
@@ -514,6 +523,19 @@ FrameBufferBltLibBufferToVideo (
 
   WidthInBytes = Width * Configure->BytesPerPixel;
 
+  if ((Configure->PixelFormat == PixelBlueGreenRedReserved8BitPerColor) &&
+      (SourceX == 0) && (Width == Configure->PixelsPerScanLine) && (Delta == WidthInBytes))
+  {
+    //
+    // Both the BltBuffer rows and the scan lines are contiguous.
+    //
+    Offset      = DestinationY * Configure->PixelsPerScanLine;
+    Destination = Configure->FrameBuffer + Configure->BytesPerPixel * Offset;
+    Source      = (UINT8 *)BltBuffer + (SourceY * Delta);
+    CopyMem (Destination, Source, WidthInBytes * Height);
+    return RETURN_SUCCESS;
+  }
+
   for (SrcY = SourceY, DstY = DestinationY;
        SrcY < (Height + SourceY);
        SrcY++, DstY++)
@@ -524,6 +546,17 @@ FrameBufferBltLibBufferToVideo (
 
     if (Configure->PixelFormat == PixelBlueGreenRedReserved8BitPerColor) {
       Source = (UINT8 *)BltBuffer + (SrcY * Delta) + SourceX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+    } else if (Configure->PixelFormat == PixelRedGreenBlueReserved8BitPerColor) {
+      //
+      // Only the red and blue bytes need to be swapped.
+      //
+      Source = (UINT8 *)BltBuffer + (SrcY * Delta) + SourceX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
+      for (IndexX = 0; IndexX < Width; IndexX++) {
+        Uint32                                    = ((UINT32 *)Source)[IndexX];
+        ((UINT32 *)Configure->LineBuffer)[IndexX] = (Uint32 & 0x0000ff00) | ((Uint32 & 0xff) << 16) | ((Uint32 >> 16) & 0xff);
+      }
+
+      Source = Configure->LineBuffer;
     } else {
       for (IndexX = 0; IndexX < Width; IndexX++) {
         Blt =
@@ -619,12 +652,21 @@ FrameBufferBltLibVideoToVideo (
   Destination = Configure->FrameBuffer + Offset;
 
   LineStride = Configure->BytesPerPixel * Configure->PixelsPerScanLine;
+  if (WidthInBytes == (UINTN)LineStride) {
+    //
+    // Full scan lines are contiguous, so move them at once. CopyMem() handles
+    // the overlap of a scrolled region.
+    //
+    CopyMem (Destination, Source, WidthInBytes * Height);
+    return RETURN_SUCCESS;
+  }
+
   if (Destination > Source) {
     //
     // Copy from last line to avoid source is corrupted by copying
     //
-    Source      += Height * LineStride;
-    Destination += Height * LineStride;
+    Source      += (Height - 1) * LineStride;
+    Destination += (Height - 1) * LineStride;
     LineStride   = -LineStride;
   }
 
@@ -26,6 +26,14 @@ EFI_GUID  mBmAutoCreateBootOptionGuid = {
   0x8108ac4e, 0x9f11, 0x4d59, { 0x85, 0x0e, 0xe2, 0x1a, 0x52, 0x2c, 0x59, 0xb2 }
 };
 
+///
+/// This GUID is used for an EFI Variable that caches the boot options enumerated
+/// from the platform together with the fingerprint of the bootable devices.
+///
+EFI_GUID  mBmBootOptionCacheVariableGuid = {
+  0x3b3ea6f4, 0x5d0c, 0x4b8e, { 0x9a, 0x61, 0x2f, 0xc7, 0x1d, 0x48, 0xe0, 0x93 }
+};
+
 /**
 
   End Perf entry of BDS
@@ -2146,6 +2154,315 @@ BmMatchPartitionDevicePathNode (
   return FALSE;
 }
 
+/**
+  Accumulate the identity of all the handles that BmEnumerateBootOptions()
+  creates boot options for into a fingerprint.
+
+  The fingerprint covers the device path of every BlockIo, SimpleFileSystem
+  and LoadFile handle as well as the BlockIo media flags which decide whether
+  a boot option is created for the handle. It changes whenever a device is
+  added, removed or moved, or removable media is inserted or ejected.
+
+  A device that is swapped for another one in the same slot keeps its device
+  path, so the fingerprint also covers the identity of every BlockIo device:
+  - the media ID, block size and last block of the media,
+  - the identify data reported by the DiskInfo protocol, which holds the
+    serial number of ATA disks and the namespace identifiers of NVMe disks,
+  - the partition GUID or MBR signature, which are part of the device path
+    of the partition handles.
+
+  @return The fingerprint of the bootable devices in the platform.
+**/
+UINT32
+BmGetBootOptionFingerprint (
+  VOID
+  )
+{
+  EFI_STATUS                Status;
+  EFI_GUID                  *Protocols[3];
+  UINTN                     ProtocolIndex;
+  UINTN                     HandleCount;
+  EFI_HANDLE                *Handles;
+  UINTN                     Index;
+  EFI_DEVICE_PATH_PROTOCOL  *DevicePath;
+  EFI_BLOCK_IO_PROTOCOL     *BlkIo;
+  BM_BLOCK_IO_IDENTITY      Identity;
+  EFI_DISK_INFO_PROTOCOL    *DiskInfo;
+  VOID                      *IdentifyData;
+  UINT32                    IdentifyDataSize;
+  UINT32                    Fingerprint;
+
+  Protocols[0] = &gEfiBlockIoProtocolGuid;
+  Protocols[1] = &gEfiSimpleFileSystemProtocolGuid;
+  Protocols[2] = &gEfiLoadFileProtocolGuid;
+
+  Fingerprint = 0;
+  for (ProtocolIndex = 0; ProtocolIndex < ARRAY_SIZE (Protocols); ProtocolIndex++) {
+    Status = gBS->LocateHandleBuffer (
+                    ByProtocol,
+                    Protocols[ProtocolIndex],
+                    NULL,
+                    &HandleCount,
+                    &Handles
+                    );
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    Fingerprint = CalculateCrc32c (Protocols[ProtocolIndex], sizeof (EFI_GUID), Fingerprint);
+    for (Index = 0; Index < HandleCount; Index++) {
+      DevicePath = DevicePathFromHandle (Handles[Index]);
+      if (DevicePath != NULL) {
+        Fingerprint = CalculateCrc32c (DevicePath, GetDevicePathSize (DevicePath), Fingerprint);
+      }
+
+      if (ProtocolIndex == 0) {
+        Status = gBS->HandleProtocol (Handles[Index], &gEfiBlockIoProtocolGuid, (VOID **)&BlkIo);
+        if (!EFI_ERROR (Status)) {
+          ZeroMem (&Identity, sizeof (Identity));
+          Identity.MediaId          = BlkIo->Media->MediaId;
+          Identity.BlockSize        = BlkIo->Media->BlockSize;
+          Identity.LastBlock        = BlkIo->Media->LastBlock;
+          Identity.LogicalPartition = BlkIo->Media->LogicalPartition;
+          Identity.RemovableMedia   = BlkIo->Media->RemovableMedia;
+          Identity.MediaPresent     = BlkIo->Media->MediaPresent;
+          Fingerprint               = CalculateCrc32c (&Identity, sizeof (Identity), Fingerprint);
+        }
+
+        Status = gBS->HandleProtocol (Handles[Index], &gEfiDiskInfoProtocolGuid, (VOID **)&DiskInfo);
+        if (!EFI_ERROR (Status)) {
+          IdentifyDataSize = 0;
+          Status           = DiskInfo->Identify (DiskInfo, NULL, &IdentifyDataSize);
+          if ((Status == EFI_BUFFER_TOO_SMALL) && (IdentifyDataSize != 0)) {
+            IdentifyData = AllocatePool (IdentifyDataSize);
+            if (IdentifyData != NULL) {
+              Status = DiskInfo->Identify (DiskInfo, IdentifyData, &IdentifyDataSize);
+              if (!EFI_ERROR (Status)) {
+                Fingerprint = CalculateCrc32c (IdentifyData, IdentifyDataSize, Fingerprint);
+              }
+
+              FreePool (IdentifyData);
+            }
+          }
+        }
+      }
+    }
+
+    FreePool (Handles);
+  }
+
+  return Fingerprint;
+}
+
+/**
+  Return the boot options saved by BmCacheBootOptions() when they were
+  enumerated from the platform with the same fingerprint.
+
+  @param Fingerprint       The fingerprint of the bootable devices in the platform.
+  @param BootOptionCount   Return the count of the cached boot options.
+
+  @return  Pointer to the cached boot option array, or NULL when the cache doesn't
+           exist, is corrupted or was created from different hardware.
+**/
+EFI_BOOT_MANAGER_LOAD_OPTION *
+BmGetCachedBootOptions (
+  IN  UINT32  Fingerprint,
+  OUT UINTN   *BootOptionCount
+  )
+{
+  EFI_STATUS                    Status;
+  BM_BOOT_OPTION_CACHE_HEADER   *Cache;
+  UINTN                         CacheSize;
+  BM_BOOT_OPTION_CACHE_ENTRY    Entry;
+  UINT8                         *Ptr;
+  UINT8                         *End;
+  CHAR16                        *Description;
+  EFI_DEVICE_PATH_PROTOCOL      *FilePath;
+  EFI_BOOT_MANAGER_LOAD_OPTION  *BootOptions;
+  UINTN                         Index;
+
+  *BootOptionCount = 0;
+
+  GetVariable2 (BM_BOOT_OPTION_CACHE_VARIABLE_NAME, &mBmBootOptionCacheVariableGuid, (VOID **)&Cache, &CacheSize);
+  if (Cache == NULL) {
+    return NULL;
+  }
+
+  if ((CacheSize < sizeof (BM_BOOT_OPTION_CACHE_HEADER)) ||
+      (Cache->Fingerprint != Fingerprint) ||
+      (Cache->Count == 0))
+  {
+    DEBUG ((DEBUG_INFO, "[Bds]Boot option cache is stale, enumerate all boot options\n"));
+    FreePool (Cache);
+    return NULL;
+  }
+
+  BootOptions = AllocateZeroPool (sizeof (EFI_BOOT_MANAGER_LOAD_OPTION) * Cache->Count);
+  if (BootOptions == NULL) {
+    FreePool (Cache);
+    return NULL;
+  }
+
+  Ptr    = (UINT8 *)(Cache + 1);
+  End    = (UINT8 *)Cache + CacheSize;
+  Status = EFI_SUCCESS;
+  for (Index = 0; Index < Cache->Count; Index++) {
+    if ((UINTN)(End - Ptr) < sizeof (Entry)) {
+      Status = EFI_VOLUME_CORRUPTED;
+      break;
+    }
+
+    CopyMem (&Entry, Ptr, sizeof (Entry));
+    Ptr += sizeof (Entry);
+    if (((UINTN)(End - Ptr) < Entry.DescriptionSize) ||
+        ((UINTN)(End - Ptr) - Entry.DescriptionSize < Entry.FilePathSize) ||
+        (Entry.DescriptionSize < sizeof (CHAR16)) ||
+        (Entry.DescriptionSize % sizeof (CHAR16) != 0))
+    {
+      Status = EFI_VOLUME_CORRUPTED;
+      break;
+    }
+
+    Description = AllocateCopyPool (Entry.DescriptionSize, Ptr);
+    FilePath    = (EFI_DEVICE_PATH_PROTOCOL *)(Ptr + Entry.DescriptionSize);
+    Ptr        += Entry.DescriptionSize + Entry.FilePathSize;
+    if (Description == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      break;
+    }
+
+    if ((Description[Entry.DescriptionSize / sizeof (CHAR16) - 1] != L'\0') ||
+        !IsDevicePathValid (FilePath, Entry.FilePathSize))
+    {
+      FreePool (Description);
+      Status = EFI_VOLUME_CORRUPTED;
+      break;
+    }
+
+    Status = EfiBootManagerInitializeLoadOption (
+               &BootOptions[Index],
+               LoadOptionNumberUnassigned,
+               LoadOptionTypeBoot,
+               LOAD_OPTION_ACTIVE,
+               Description,
+               FilePath,
+               NULL,
+               0
+               );
+    FreePool (Description);
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "[Bds]Boot option cache is invalid - %r\n", Status));
+    EfiBootManagerFreeLoadOptions (BootOptions, Index);
+    FreePool (Cache);
+    return NULL;
+  }
+
+  *BootOptionCount = Cache->Count;
+  FreePool (Cache);
+  return BootOptions;
+}
+
+/**
+  Save the enumerated boot options together with the fingerprint of the
+  platform they were enumerated from, so that the next boot on unchanged
+  hardware can skip querying every device for its boot description.
+
+  @param Fingerprint       The fingerprint of the bootable devices in the platform.
+  @param BootOptions       Array of the enumerated boot options.
+  @param BootOptionCount   Count of the enumerated boot options.
+**/
+VOID
+BmCacheBootOptions (
+  IN UINT32                        Fingerprint,
+  IN EFI_BOOT_MANAGER_LOAD_OPTION  *BootOptions,
+  IN UINTN                         BootOptionCount
+  )
+{
+  EFI_STATUS                   Status;
+  BM_BOOT_OPTION_CACHE_HEADER  *Cache;
+  UINTN                        CacheSize;
+  BM_BOOT_OPTION_CACHE_ENTRY   Entry;
+  UINT8                        *Ptr;
+  UINTN                        Index;
+
+  CacheSize = sizeof (BM_BOOT_OPTION_CACHE_HEADER);
+  for (Index = 0; Index < BootOptionCount; Index++) {
+    CacheSize += sizeof (BM_BOOT_OPTION_CACHE_ENTRY) +
+                 StrSize (BootOptions[Index].Description) +
+                 GetDevicePathSize (BootOptions[Index].FilePath);
+  }
+
+  Cache = AllocatePool (CacheSize);
+  if (Cache == NULL) {
+    return;
+  }
+
+  Cache->Fingerprint = Fingerprint;
+  Cache->Count       = (UINT32)BootOptionCount;
+  Ptr                = (UINT8 *)(Cache + 1);
+  for (Index = 0; Index < BootOptionCount; Index++) {
+    Entry.DescriptionSize = (UINT32)StrSize (BootOptions[Index].Description);
+    Entry.FilePathSize    = (UINT32)GetDevicePathSize (BootOptions[Index].FilePath);
+    CopyMem (Ptr, &Entry, sizeof (Entry));
+    Ptr += sizeof (Entry);
+    CopyMem (Ptr, BootOptions[Index].Description, Entry.DescriptionSize);
+    Ptr += Entry.DescriptionSize;
+    CopyMem (Ptr, BootOptions[Index].FilePath, Entry.FilePathSize);
+    Ptr += Entry.FilePathSize;
+  }
+
+  //
+  // Failing to save only impacts performance next time enumerating the boot options.
+  //
+  Status = gRT->SetVariable (
+                  BM_BOOT_OPTION_CACHE_VARIABLE_NAME,
+                  &mBmBootOptionCacheVariableGuid,
+                  EFI_VARIABLE_BOOTSERVICE_ACCESS | EFI_VARIABLE_NON_VOLATILE,
+                  CacheSize,
+                  Cache
+                  );
+  DEBUG ((DEBUG_INFO, "[Bds]Cache %u enumerated boot options - %r\n", (UINT32)BootOptionCount, Status));
+  FreePool (Cache);
+}
+
+/**
+  Query the platform boot description handlers for the description of each
+  enumerated boot option. The description of the boot options is replaced when
+  a handler returns a better one.
+
+  @param BootOptions       Array of the enumerated boot options.
+  @param BootOptionCount   Count of the enumerated boot options.
+**/
+VOID
+BmUpdatePlatformBootDescription (
+  IN OUT EFI_BOOT_MANAGER_LOAD_OPTION  *BootOptions,
+  IN     UINTN                         BootOptionCount
+  )
+{
+  EFI_STATUS                Status;
+  UINTN                     Index;
+  EFI_DEVICE_PATH_PROTOCOL  *RemainingDevicePath;
+  EFI_HANDLE                Handle;
+
+  for (Index = 0; Index < BootOptionCount; Index++) {
+    //
+    // The enumerated boot options point to the whole device path of a handle.
+    //
+    RemainingDevicePath = BootOptions[Index].FilePath;
+    Status              = gBS->LocateDevicePath (&gEfiDevicePathProtocolGuid, &RemainingDevicePath, &Handle);
+    if (EFI_ERROR (Status) || !IsDevicePathEnd (RemainingDevicePath)) {
+      continue;
+    }
+
+    BootOptions[Index].Description = BmGetPlatformBootDescription (Handle, BootOptions[Index].Description);
+  }
+}
+
 /**
   Emuerate all possible bootable medias in the following order:
   1. Removable BlockIo            - The boot option only points to the removable media
@@ -2176,11 +2493,27 @@ BmEnumerateBootOptions (
   UINTN                         Removable;
   UINTN                         Index;
   CHAR16                        *Description;
+  UINT32                        Fingerprint;
 
   ASSERT (BootOptionCount != NULL);
 
   *BootOptionCount = 0;
   BootOptions      = NULL;
+  Fingerprint      = 0;
+
+  //
+  // Reuse the boot options enumerated in the last boot when the bootable devices
+  // don't change, so that the devices aren't queried again for the descriptions.
+  //
+  if (FeaturePcdGet (PcdBootManagerCacheEnumeratedBootOptions)) {
+    Fingerprint = BmGetBootOptionFingerprint ();
+    BootOptions = BmGetCachedBootOptions (Fingerprint, BootOptionCount);
+    if (BootOptions != NULL) {
+      BmUpdatePlatformBootDescription (BootOptions, *BootOptionCount);
+      BmMakeBootOptionDescriptionUnique (BootOptions, *BootOptionCount);
+      return BootOptions;
+    }
+  }
 
   //
   // Parse removable block io followed by fixed block io
@@ -2227,7 +2560,7 @@ BmEnumerateBootOptions (
         continue;
       }
 
-      Description = BmGetBootDescription (Handles[Index]);
+      Description = BmGetDefaultBootDescription (Handles[Index]);
       BootOptions = ReallocatePool (
                       sizeof (EFI_BOOT_MANAGER_LOAD_OPTION) * (*BootOptionCount),
                       sizeof (EFI_BOOT_MANAGER_LOAD_OPTION) * (*BootOptionCount + 1),
@@ -2278,7 +2611,7 @@ BmEnumerateBootOptions (
       continue;
     }
 
-    Description = BmGetBootDescription (Handles[Index]);
+    Description = BmGetDefaultBootDescription (Handles[Index]);
     BootOptions = ReallocatePool (
                     sizeof (EFI_BOOT_MANAGER_LOAD_OPTION) * (*BootOptionCount),
                     sizeof (EFI_BOOT_MANAGER_LOAD_OPTION) * (*BootOptionCount + 1),
@@ -2322,7 +2655,7 @@ BmEnumerateBootOptions (
       continue;
     }
 
-    Description = BmGetBootDescription (Handles[Index]);
+    Description = BmGetDefaultBootDescription (Handles[Index]);
     BootOptions = ReallocatePool (
                     sizeof (EFI_BOOT_MANAGER_LOAD_OPTION) * (*BootOptionCount),
                     sizeof (EFI_BOOT_MANAGER_LOAD_OPTION) * (*BootOptionCount + 1),
@@ -2348,7 +2681,17 @@ BmEnumerateBootOptions (
     FreePool (Handles);
   }
 
+  //
+  // Cache the default descriptions, so that the platform boot description
+  // handlers are always queried, also for the cached boot options.
+  //
+  if (FeaturePcdGet (PcdBootManagerCacheEnumeratedBootOptions) && (*BootOptionCount != 0)) {
+    BmCacheBootOptions (Fingerprint, BootOptions, *BootOptionCount);
+  }
+
+  BmUpdatePlatformBootDescription (BootOptions, *BootOptionCount);
   BmMakeBootOptionDescriptionUnique (BootOptions, *BootOptionCount);
+
   return BootOptions;
 }
 
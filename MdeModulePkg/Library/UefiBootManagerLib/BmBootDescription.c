@@ -788,27 +788,22 @@ BM_GET_BOOT_DESCRIPTION  mBmBootDescriptionHandlers[] = {
 };
 
 /**
-  Return the boot description for the controller.
+  Return the default boot description for the controller, which is built by
+  the core boot description handlers.
 
   @param Handle                Controller handle.
 
   @return  The description string.
 **/
 CHAR16 *
-BmGetBootDescription (
+BmGetDefaultBootDescription (
   IN EFI_HANDLE  Handle
   )
 {
-  LIST_ENTRY                 *Link;
-  BM_BOOT_DESCRIPTION_ENTRY  *Entry;
-  CHAR16                     *Description;
-  CHAR16                     *DefaultDescription;
-  CHAR16                     *Temp;
-  UINTN                      Index;
+  CHAR16  *DefaultDescription;
+  CHAR16  *Temp;
+  UINTN   Index;
 
-  //
-  // Firstly get the default boot description
-  //
   DefaultDescription = NULL;
   for (Index = 0; Index < ARRAY_SIZE (mBmBootDescriptionHandlers); Index++) {
     DefaultDescription = mBmBootDescriptionHandlers[Index](Handle);
@@ -828,10 +823,30 @@ BmGetBootDescription (
   }
 
   ASSERT (DefaultDescription != NULL);
+  return DefaultDescription;
+}
+
+/**
+  Query the platform boot description handlers for a better boot description
+  of the controller.
+
+  @param Handle                Controller handle.
+  @param DefaultDescription    The default boot description of the controller.
+                               It is freed when a platform handler returns a
+                               better one.
+
+  @return  The description string.
+**/
+CHAR16 *
+BmGetPlatformBootDescription (
+  IN EFI_HANDLE  Handle,
+  IN CHAR16      *DefaultDescription
+  )
+{
+  LIST_ENTRY                 *Link;
+  BM_BOOT_DESCRIPTION_ENTRY  *Entry;
+  CHAR16                     *Description;
 
-  //
-  // Secondly query platform for the better boot description
-  //
   for ( Link = GetFirstNode (&mPlatformBootDescriptionHandlers)
         ; !IsNull (&mPlatformBootDescriptionHandlers, Link)
         ; Link = GetNextNode (&mPlatformBootDescriptionHandlers, Link)
@@ -848,6 +863,25 @@ BmGetBootDescription (
   return DefaultDescription;
 }
 
+/**
+  Return the boot description for the controller.
+
+  @param Handle                Controller handle.
+
+  @return  The description string.
+**/
+CHAR16 *
+BmGetBootDescription (
+  IN EFI_HANDLE  Handle
+  )
+{
+  //
+  // Firstly get the default boot description,
+  // secondly query platform for the better boot description
+  //
+  return BmGetPlatformBootDescription (Handle, BmGetDefaultBootDescription (Handle));
+}
+
 /**
   Enumerate all boot option descriptions and append " 2"/" 3"/... to make
   unique description.
@@ -92,6 +92,39 @@ typedef enum {
   BmMiscBoot
 } BM_BOOT_TYPE;
 
+//
+// Name of the variable caching the enumerated boot options.
+//
+#define BM_BOOT_OPTION_CACHE_VARIABLE_NAME  L"BootOptionCache"
+
+///
+/// Layout of the variable caching the enumerated boot options.
+/// The header is followed by Count entries. Each entry is followed by the
+/// NULL-terminated description and the device path of the boot option.
+///
+typedef struct {
+  UINT32    Fingerprint;
+  UINT32    Count;
+} BM_BOOT_OPTION_CACHE_HEADER;
+
+typedef struct {
+  UINT32    DescriptionSize;
+  UINT32    FilePathSize;
+} BM_BOOT_OPTION_CACHE_ENTRY;
+
+///
+/// The media properties of a BlockIo device that are part of the fingerprint
+/// of the bootable devices.
+///
+typedef struct {
+  UINT32     MediaId;
+  UINT32     BlockSize;
+  EFI_LBA    LastBlock;
+  BOOLEAN    LogicalPartition;
+  BOOLEAN    RemovableMedia;
+  BOOLEAN    MediaPresent;
+} BM_BLOCK_IO_IDENTITY;
+
 typedef
 CHAR16 *
 (*BM_GET_BOOT_DESCRIPTION) (
@@ -367,6 +400,36 @@ BmGetBootDescription (
   IN EFI_HANDLE  Handle
   );
 
+/**
+  Return the default boot description for the controller, which is built by
+  the core boot description handlers.
+
+  @param Handle                Controller handle.
+
+  @return  The description string.
+**/
+CHAR16 *
+BmGetDefaultBootDescription (
+  IN EFI_HANDLE  Handle
+  );
+
+/**
+  Query the platform boot description handlers for a better boot description
+  of the controller.
+
+  @param Handle                Controller handle.
+  @param DefaultDescription    The default boot description of the controller.
+                               It is freed when a platform handler returns a
+                               better one.
+
+  @return  The description string.
+**/
+CHAR16 *
+BmGetPlatformBootDescription (
+  IN EFI_HANDLE  Handle,
+  IN CHAR16      *DefaultDescription
+  );
+
 /**
   Enumerate all boot option descriptions and append " 2"/" 3"/... to make
   unique description.
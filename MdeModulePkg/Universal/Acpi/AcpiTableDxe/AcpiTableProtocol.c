@@ -343,9 +343,10 @@ ReallocateAcpiTableBuffer (
 
   CopyMem (&TempPrivateData, AcpiTableInstance, sizeof (EFI_ACPI_TABLE_INSTANCE));
   //
-  // Enlarge the max table number from mEfiAcpiMaxNumTables to mEfiAcpiMaxNumTables + EFI_ACPI_MAX_NUM_TABLES
+  // Double the max table number, so that installing a large number of tables
+  // reallocates and copies the RSDT and XSDT a logarithmic number of times.
   //
-  NewMaxTableNumber = mEfiAcpiMaxNumTables + EFI_ACPI_MAX_NUM_TABLES;
+  NewMaxTableNumber = mEfiAcpiMaxNumTables * 2;
   //
   // Create RSDT, XSDT structures and allocate buffers.
   //
@@ -1133,7 +1134,10 @@ AddTableToList (
     }
   }
 
-  ChecksumCommonTables (AcpiTableInstance);
+  //
+  // The RSDT/XSDT checksums are not updated here. Every caller publishes the
+  // tables with PublishTables() after adding them, which does the checksums.
+  //
   return EFI_SUCCESS;
 }
 
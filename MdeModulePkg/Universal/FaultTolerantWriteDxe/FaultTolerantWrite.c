@@ -177,6 +177,9 @@ FtwAllocate (
   @param Fvb             The FVB protocol that provides services for
                          reading, writing, and erasing the target block.
   @param BlockSize       The size of the block.
+  @param Restart         TRUE if an interrupted write is restarted. The target
+                         blocks are then always erased and programmed, even if
+                         they read back as the new content.
 
   @retval  EFI_SUCCESS          The function completed successfully
   @retval  EFI_ABORTED          The function could not complete successfully
@@ -186,7 +189,8 @@ EFI_STATUS
 FtwWriteRecord (
   IN EFI_FAULT_TOLERANT_WRITE_PROTOCOL   *This,
   IN EFI_FIRMWARE_VOLUME_BLOCK_PROTOCOL  *Fvb,
-  IN UINTN                               BlockSize
+  IN UINTN                               BlockSize,
+  IN BOOLEAN                             Restart
   )
 {
   EFI_STATUS                       Status;
@@ -237,7 +241,7 @@ FtwWriteRecord (
     // Update blocks other than working block or boot block
     //
     NumberOfWriteBlocks = FTW_BLOCKS ((UINTN)(Record->Offset + Record->Length), BlockSize);
-    Status              = FlushSpareBlockToTargetBlock (FtwDevice, Fvb, Record->Lba, BlockSize, NumberOfWriteBlocks);
+    Status              = FlushSpareBlockToTargetBlock (FtwDevice, Fvb, Record->Lba, BlockSize, NumberOfWriteBlocks, (BOOLEAN)!Restart);
   }
 
   if (EFI_ERROR (Status)) {
@@ -338,6 +342,8 @@ FtwWrite (
   UINTN                               NumberOfBlocks;
   UINTN                               NumberOfWriteBlocks;
   UINTN                               WriteLength;
+  UINTN                               ProgramLength;
+  UINTN                               EraseCount;
 
   FtwDevice = FTW_CONTEXT_FROM_THIS (This);
 
@@ -529,12 +535,21 @@ FtwWrite (
   //
   // Write the memory buffer to spare block
   // Do not assume Spare Block and Target Block have same block size
-  //
-  Status = FtwEraseSpareBlock (FtwDevice);
-  if (EFI_ERROR (Status)) {
-    FreePool (MyBuffer);
-    FreePool (SpareBuffer);
-    return EFI_ABORTED;
+  // Only skip the erase if Restart() or a previous write left the spare block
+  // erased and it still reads back erased. Erased bytes at the end of each
+  // block need not be programmed.
+  //
+  EraseCount = FtwDevice->EraseCount;
+  if (FtwDevice->SpareErased && IsErasedFlashBuffer (SpareBuffer, SpareBufferSize)) {
+    FtwDevice->SpareErased     = FALSE;
+    FtwDevice->EraseSkipCount += FtwDevice->NumberOfSpareBlock;
+  } else {
+    Status = FtwEraseSpareBlock (FtwDevice);
+    if (EFI_ERROR (Status)) {
+      FreePool (MyBuffer);
+      FreePool (SpareBuffer);
+      return EFI_ABORTED;
+    }
   }
 
   Ptr = MyBuffer;
@@ -545,17 +560,20 @@ FtwWrite (
       MyLength = MyBufferSize;
     }
 
-    Status = FtwDevice->FtwBackupFvb->Write (
-                                        FtwDevice->FtwBackupFvb,
-                                        FtwDevice->FtwSpareLba + Index,
-                                        0,
-                                        &MyLength,
-                                        Ptr
-                                        );
-    if (EFI_ERROR (Status)) {
-      FreePool (MyBuffer);
-      FreePool (SpareBuffer);
-      return EFI_ABORTED;
+    ProgramLength = FtwGetProgramLength (Ptr, MyLength);
+    if (ProgramLength != 0) {
+      Status = FtwDevice->FtwBackupFvb->Write (
+                                          FtwDevice->FtwBackupFvb,
+                                          FtwDevice->FtwSpareLba + Index,
+                                          0,
+                                          &ProgramLength,
+                                          Ptr
+                                          );
+      if (EFI_ERROR (Status)) {
+        FreePool (MyBuffer);
+        FreePool (SpareBuffer);
+        return EFI_ABORTED;
+      }
     }
 
     Ptr          += MyLength;
@@ -589,7 +607,7 @@ FtwWrite (
   //  Since the content has already backuped in spare block, the write is
   //  guaranteed to be completed with fault tolerant manner.
   //
-  Status = FtwWriteRecord (This, Fvb, BlockSize);
+  Status = FtwWriteRecord (This, Fvb, BlockSize, FALSE);
   if (EFI_ERROR (Status)) {
     FreePool (SpareBuffer);
     return EFI_ABORTED;
@@ -606,22 +624,27 @@ FtwWrite (
 
   Ptr = SpareBuffer;
   for (Index = 0; Index < FtwDevice->NumberOfSpareBlock; Index += 1) {
-    MyLength = FtwDevice->SpareBlockSize;
-    Status   = FtwDevice->FtwBackupFvb->Write (
+    MyLength      = FtwDevice->SpareBlockSize;
+    ProgramLength = FtwGetProgramLength (Ptr, MyLength);
+    if (ProgramLength != 0) {
+      Status = FtwDevice->FtwBackupFvb->Write (
                                           FtwDevice->FtwBackupFvb,
                                           FtwDevice->FtwSpareLba + Index,
                                           0,
-                                          &MyLength,
+                                          &ProgramLength,
                                           Ptr
                                           );
-    if (EFI_ERROR (Status)) {
-      FreePool (SpareBuffer);
-      return EFI_ABORTED;
+      if (EFI_ERROR (Status)) {
+        FreePool (SpareBuffer);
+        return EFI_ABORTED;
+      }
     }
 
     Ptr += MyLength;
   }
 
+  FtwDevice->SpareErased = IsErasedFlashBuffer (SpareBuffer, SpareBufferSize);
+
   //
   // All success.
   //
@@ -629,10 +652,13 @@ FtwWrite (
 
   DEBUG (
     (DEBUG_INFO,
-     "Ftw: Write() success, (Lba:Offset)=(%lx:0x%x), Length: 0x%x\n",
+     "Ftw: Write() success, (Lba:Offset)=(%lx:0x%x), Length: 0x%x, Erased blocks: %Lu (total %Lu, avoided %Lu)\n",
      Lba,
      Offset,
-     Length)
+     Length,
+     (UINT64)(FtwDevice->EraseCount - EraseCount),
+     (UINT64)FtwDevice->EraseCount,
+     (UINT64)FtwDevice->EraseSkipCount)
     );
 
   return EFI_SUCCESS;
@@ -717,7 +743,7 @@ FtwRestart (
   //  Since the content has already backuped in spare block, the write is
   //  guaranteed to be completed with fault tolerant manner.
   //
-  Status = FtwWriteRecord (This, Fvb, BlockSize);
+  Status = FtwWriteRecord (This, Fvb, BlockSize, TRUE);
   if (EFI_ERROR (Status)) {
     return EFI_ABORTED;
   }
@@ -731,6 +757,8 @@ FtwRestart (
     return EFI_ABORTED;
   }
 
+  FtwDevice->SpareErased = TRUE;
+
   DEBUG ((DEBUG_INFO, "%a(): success\n", __func__));
   return EFI_SUCCESS;
 }
@@ -78,6 +78,9 @@ typedef struct {
   EFI_LBA                                    FtwWorkSpaceLbaInSpare;  // Start LBA of working space in spare block.
   UINTN                                      FtwWorkSpaceBaseInSpare; // Offset into the FtwWorkSpaceLbaInSpare block.
   UINT8                                      *FtwWorkSpace;           // Point to Work Space in memory buffer
+  UINTN                                      EraseCount;              // Number of blocks erased by FTW.
+  UINTN                                      EraseSkipCount;          // Number of block erases avoided by FTW.
+  BOOLEAN                                    SpareErased;             // TRUE if FTW left the spare block erased.
   //
   // Following a buffer of FtwWorkSpace[FTW_WORK_SPACE_SIZE],
   // Allocated with EFI_FTW_DEVICE.
@@ -358,6 +361,7 @@ IsBootBlock (
   @param Lba             Lba of the target block
   @param BlockSize       The size of the block
   @param NumberOfBlocks  The number of consecutive blocks starting with Lba
+  @param SkipUnchanged   TRUE to leave the blocks that hold the new content alone
 
   @retval  EFI_SUCCESS               Spare block content is copied to target block
   @retval  EFI_INVALID_PARAMETER     Input parameter error
@@ -371,7 +375,8 @@ FlushSpareBlockToTargetBlock (
   EFI_FIRMWARE_VOLUME_BLOCK_PROTOCOL  *FvBlock,
   EFI_LBA                             Lba,
   UINTN                               BlockSize,
-  UINTN                               NumberOfBlocks
+  UINTN                               NumberOfBlocks,
+  BOOLEAN                             SkipUnchanged
   );
 
 /**
@@ -562,6 +567,22 @@ IsErasedFlashBuffer (
   IN UINTN  BufferSize
   );
 
+/**
+  Get the number of bytes of a buffer that must be programmed to an erased
+  flash block, that is the length without the trailing erased bytes.
+
+  @param Buffer          Buffer to check
+  @param BufferSize      Size of the buffer
+
+  @return The number of bytes up to and including the last non-erased byte.
+
+**/
+UINTN
+FtwGetProgramLength (
+  IN UINT8  *Buffer,
+  IN UINTN  BufferSize
+  );
+
 /**
   Initialize a work space when there is no work space.
 
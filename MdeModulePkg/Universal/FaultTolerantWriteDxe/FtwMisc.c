@@ -41,6 +41,29 @@ IsErasedFlashBuffer (
   return IsEmpty;
 }
 
+/**
+  Get the number of bytes of a buffer that must be programmed to an erased
+  flash block, that is the length without the trailing erased bytes.
+
+  @param Buffer          Buffer to check
+  @param BufferSize      Size of the buffer
+
+  @return The number of bytes up to and including the last non-erased byte.
+
+**/
+UINTN
+FtwGetProgramLength (
+  IN UINT8  *Buffer,
+  IN UINTN  BufferSize
+  )
+{
+  while ((BufferSize > 0) && (Buffer[BufferSize - 1] == FTW_ERASED_BYTE)) {
+    BufferSize--;
+  }
+
+  return BufferSize;
+}
+
 /**
   To erase the block with specified blocks.
 
@@ -62,6 +85,8 @@ FtwEraseBlock (
   UINTN                               NumberOfBlocks
   )
 {
+  FtwDevice->EraseCount += NumberOfBlocks;
+
   return FvBlock->EraseBlocks (
                     FvBlock,
                     Lba,
@@ -92,6 +117,13 @@ FtwEraseSpareBlock (
   IN EFI_FTW_DEVICE  *FtwDevice
   )
 {
+  //
+  // The caller programs the spare block after erasing it, so it is up to the
+  // caller to set SpareErased again if it leaves the spare block erased.
+  //
+  FtwDevice->SpareErased = FALSE;
+  FtwDevice->EraseCount += FtwDevice->NumberOfSpareBlock;
+
   return FtwDevice->FtwBackupFvb->EraseBlocks (
                                     FtwDevice->FtwBackupFvb,
                                     FtwDevice->FtwSpareLba,
@@ -461,12 +493,18 @@ FlushSpareBlockToBootBlock (
   Spare block is accessed by FTW backup FVB protocol interface.
   Target block is accessed by FvBlock protocol interface.
 
+  The trailing erased bytes of a block are not programmed after it is erased.
+  If SkipUnchanged is TRUE, target blocks that already hold the new content
+  are left alone. This must not be used when an interrupted write is
+  restarted, because a block whose programming was cut off by a power loss
+  can read back as expected while holding weakly programmed bits.
 
   @param FtwDevice       The private data of FTW driver
   @param FvBlock         FVB Protocol interface to access target block
   @param Lba             Lba of the target block
   @param BlockSize       The size of the block
   @param NumberOfBlocks  The number of consecutive blocks starting with Lba
+  @param SkipUnchanged   TRUE to leave the blocks that hold the new content alone
 
   @retval  EFI_SUCCESS               Spare block content is copied to target block
   @retval  EFI_INVALID_PARAMETER     Input parameter error
@@ -480,12 +518,14 @@ FlushSpareBlockToTargetBlock (
   EFI_FIRMWARE_VOLUME_BLOCK_PROTOCOL  *FvBlock,
   EFI_LBA                             Lba,
   UINTN                               BlockSize,
-  UINTN                               NumberOfBlocks
+  UINTN                               NumberOfBlocks,
+  BOOLEAN                             SkipUnchanged
   )
 {
   EFI_STATUS  Status;
   UINTN       Length;
   UINT8       *Buffer;
+  UINT8       *TargetBuffer;
   UINTN       Count;
   UINT8       *Ptr;
   UINTN       Index;
@@ -524,34 +564,52 @@ FlushSpareBlockToTargetBlock (
     Ptr += Count;
   }
 
-  //
-  // Erase the target block
-  //
-  Status = FtwEraseBlock (FtwDevice, FvBlock, Lba, NumberOfBlocks);
-  if (EFI_ERROR (Status)) {
+  TargetBuffer = AllocatePool (BlockSize);
+  if (TargetBuffer == NULL) {
     FreePool (Buffer);
-    return EFI_ABORTED;
+    return EFI_OUT_OF_RESOURCES;
   }
 
   //
-  // Write memory buffer to block, using the FvBlock protocol interface
+  // Erase and write the target blocks one by one, using the FvBlock protocol
+  // interface. Skip the blocks whose content is already up to date.
   //
   Ptr = Buffer;
-  for (Index = 0; Index < NumberOfBlocks; Index += 1) {
-    Count  = BlockSize;
+  for (Index = 0; Index < NumberOfBlocks; Index += 1, Ptr += BlockSize) {
+    if (SkipUnchanged) {
+      Count  = BlockSize;
+      Status = FvBlock->Read (FvBlock, Lba + Index, 0, &Count, TargetBuffer);
+      if (!EFI_ERROR (Status) && (Count == BlockSize) && (CompareMem (TargetBuffer, Ptr, BlockSize) == 0)) {
+        FtwDevice->EraseSkipCount++;
+        continue;
+      }
+    }
+
+    Status = FtwEraseBlock (FtwDevice, FvBlock, Lba + Index, 1);
+    if (EFI_ERROR (Status)) {
+      FreePool (TargetBuffer);
+      FreePool (Buffer);
+      return EFI_ABORTED;
+    }
+
+    Count = FtwGetProgramLength (Ptr, BlockSize);
+    if (Count == 0) {
+      continue;
+    }
+
     Status = FvBlock->Write (FvBlock, Lba + Index, 0, &Count, Ptr);
     if (EFI_ERROR (Status)) {
       DEBUG ((DEBUG_ERROR, "Ftw: FVB Write block - %r\n", Status));
+      FreePool (TargetBuffer);
       FreePool (Buffer);
       return Status;
     }
-
-    Ptr += Count;
   }
 
+  FreePool (TargetBuffer);
   FreePool (Buffer);
 
-  return Status;
+  return EFI_SUCCESS;
 }
 
 /**
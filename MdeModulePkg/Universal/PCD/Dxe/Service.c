@@ -31,6 +31,13 @@ LIST_ENTRY  *mCallbackFnTable;
 EFI_GUID    **TmpTokenSpaceBuffer;
 UINTN       TmpTokenSpaceBufferCount;
 
+//
+// Open addressing hash table for the dynamic-ex token number lookup, NULL if
+// it could not be built.
+//
+PCD_EX_TOKEN_HASH_ENTRY  *mExTokenHashTable    = NULL;
+UINTN                    mExTokenHashTableMask = 0;
+
 UINTN             mPeiPcdDbSize    = 0;
 PEI_PCD_DATABASE  *mPeiPcdDbBinary = NULL;
 UINTN             mDxePcdDbSize    = 0;
@@ -950,6 +957,117 @@ BuildPcdDxeDataBase (
   for (Index = 0; Index + 1 < mPcdTotalTokenCount + 1; Index++) {
     InitializeListHead (&mCallbackFnTable[Index]);
   }
+
+  BuildExTokenHashTable ();
+}
+
+/**
+  Calculate the hash value of dynamic-ex PCD's {token space guid:token number}.
+
+  @param Guid            Token space guid for dynamic-ex PCD entry.
+  @param ExTokenNumber   Dynamic-ex PCD token number.
+
+  @return The hash value.
+
+**/
+UINTN
+ExTokenHash (
+  IN CONST EFI_GUID  *Guid,
+  IN UINT32          ExTokenNumber
+  )
+{
+  return (UINTN)((Guid->Data1 ^ ReadUnaligned32 ((CONST UINT32 *)Guid->Data4)) ^ (ExTokenNumber * 0x9E3779B1U));
+}
+
+/**
+  Add the entries of a DynamicEx mapping table to the hash table.
+
+  An entry whose {token space guid:token number} is already in the hash table
+  is skipped, so that the PEI PCD database, which is added first, keeps
+  precedence as in the linear search.
+
+  @param Database   The PEI or DXE PCD database.
+
+**/
+VOID
+AddExMapTableToHashTable (
+  IN PCD_DATABASE_INIT  *Database
+  )
+{
+  DYNAMICEX_MAPPING  *ExMap;
+  EFI_GUID           *GuidTable;
+  EFI_GUID           *Guid;
+  UINTN              Index;
+  UINTN              Slot;
+
+  ExMap     = (DYNAMICEX_MAPPING *)((UINT8 *)Database + Database->ExMapTableOffset);
+  GuidTable = (EFI_GUID *)((UINT8 *)Database + Database->GuidTableOffset);
+
+  for (Index = 0; Index < Database->ExTokenCount; Index++) {
+    Guid = &GuidTable[ExMap[Index].ExGuidIndex];
+    Slot = ExTokenHash (Guid, ExMap[Index].ExTokenNumber) & mExTokenHashTableMask;
+    while (mExTokenHashTable[Slot].Guid != NULL) {
+      if ((mExTokenHashTable[Slot].ExTokenNumber == ExMap[Index].ExTokenNumber) &&
+          CompareGuid (mExTokenHashTable[Slot].Guid, Guid))
+      {
+        break;
+      }
+
+      Slot = (Slot + 1) & mExTokenHashTableMask;
+    }
+
+    if (mExTokenHashTable[Slot].Guid == NULL) {
+      mExTokenHashTable[Slot].Guid          = Guid;
+      mExTokenHashTable[Slot].ExTokenNumber = ExMap[Index].ExTokenNumber;
+      mExTokenHashTable[Slot].TokenNumber   = ExMap[Index].TokenNumber;
+    }
+  }
+}
+
+/**
+  Build the hash table that maps dynamic-ex PCD's {token space guid:token number}
+  to Token Number, from the DynamicEx mapping tables of the PEI and DXE PCD
+  databases.
+
+**/
+VOID
+BuildExTokenHashTable (
+  VOID
+  )
+{
+  UINTN  ExTokenCount;
+  UINTN  TableSize;
+
+  ExTokenCount = mPcdDatabase.DxeDb->ExTokenCount;
+  if (!mPeiDatabaseEmpty) {
+    ExTokenCount += mPcdDatabase.PeiDb->ExTokenCount;
+  }
+
+  if (ExTokenCount == 0) {
+    return;
+  }
+
+  //
+  // Keep the load factor at or below one half, so that the probe sequences
+  // stay short.
+  //
+  TableSize = (UINTN)GetPowerOfTwo32 ((UINT32)ExTokenCount) << 2;
+
+  mExTokenHashTable = AllocateZeroPool (TableSize * sizeof (PCD_EX_TOKEN_HASH_ENTRY));
+  if (mExTokenHashTable == NULL) {
+    //
+    // Fall back to the linear search of the mapping tables.
+    //
+    return;
+  }
+
+  mExTokenHashTableMask = TableSize - 1;
+
+  if (!mPeiDatabaseEmpty) {
+    AddExMapTableToHashTable (mPcdDatabase.PeiDb);
+  }
+
+  AddExMapTableToHashTable (mPcdDatabase.DxeDb);
 }
 
 /**
@@ -1592,6 +1710,24 @@ GetExPcdTokenNumber (
   EFI_GUID           *GuidTable;
   EFI_GUID           *MatchGuid;
   UINTN              MatchGuidIdx;
+  UINTN              Slot;
+
+  if (mExTokenHashTable != NULL) {
+    Slot = ExTokenHash (Guid, ExTokenNumber) & mExTokenHashTableMask;
+    while (mExTokenHashTable[Slot].Guid != NULL) {
+      if ((mExTokenHashTable[Slot].ExTokenNumber == ExTokenNumber) &&
+          CompareGuid (mExTokenHashTable[Slot].Guid, Guid))
+      {
+        return mExTokenHashTable[Slot].TokenNumber;
+      }
+
+      Slot = (Slot + 1) & mExTokenHashTableMask;
+    }
+
+    DEBUG ((DEBUG_ERROR, "%a: Failed to find PCD with GUID: %g and token number: %d\n", __func__, Guid, ExTokenNumber));
+    ASSERT (FALSE);
+    return 0;
+  }
 
   if (!mPeiDatabaseEmpty) {
     ExMap     = (DYNAMICEX_MAPPING *)((UINT8 *)mPcdDatabase.PeiDb + mPcdDatabase.PeiDb->ExMapTableOffset);
@@ -805,6 +805,16 @@ typedef struct {
   PCD_PROTOCOL_CALLBACK    CallbackFn;
 } CALLBACK_FN_ENTRY;
 
+//
+// Entry of the hash table for dynamic-ex PCD's {token space guid:token number}.
+// Guid points into the GUID table of the PCD database, NULL for a free entry.
+//
+typedef struct {
+  CONST EFI_GUID    *Guid;
+  UINT32            ExTokenNumber;
+  UINT32            TokenNumber;
+} PCD_EX_TOKEN_HASH_ENTRY;
+
 #define CR_FNENTRY_FROM_LISTNODE(Record, Type, Field)  BASE_CR(Record, Type, Field)
 
 //
@@ -1054,6 +1064,17 @@ BuildPcdDxeDataBase (
   VOID
   );
 
+/**
+  Build the hash table that maps dynamic-ex PCD's {token space guid:token number}
+  to Token Number, from the DynamicEx mapping tables of the PEI and DXE PCD
+  databases.
+
+**/
+VOID
+BuildExTokenHashTable (
+  VOID
+  );
+
 /**
   Get Token Number according to dynamic-ex PCD's {token space guid:token number}
 
@@ -1185,6 +1206,9 @@ extern  BOOLEAN  mPeiExMapTableEmpty;
 extern  BOOLEAN  mDxeExMapTableEmpty;
 extern  BOOLEAN  mPeiDatabaseEmpty;
 
+extern  PCD_EX_TOKEN_HASH_ENTRY  *mExTokenHashTable;
+extern  UINTN                    mExTokenHashTableMask;
+
 extern  EFI_GUID  **TmpTokenSpaceBuffer;
 extern  UINTN     TmpTokenSpaceBufferCount;
 
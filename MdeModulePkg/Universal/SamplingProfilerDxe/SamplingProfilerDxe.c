@@ -0,0 +1,360 @@
+/** @file
+  Sampling profiler for the DXE phase.
+
+  The driver registers a periodic callback through the Debug Support protocol,
+  which is invoked on every system timer interrupt with the context of the
+  interrupted code. The interrupted instruction pointer is recorded in a
+  pre-allocated sample buffer, so the cost per tick is a single store.
+
+  At ReadyToBoot the sampling stops. The samples are attributed to the images
+  recorded in the Debug Image Info Table and aggregated into a folded profile,
+  which is installed as the gEdkiiSamplingProfileGuid configuration table.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiDxe.h>
+
+#include <Protocol/DebugSupport.h>
+#include <Protocol/Timer.h>
+#include <Guid/DebugImageInfoTable.h>
+#include <Guid/SamplingProfile.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/PeCoffGetEntryPointLib.h>
+#include <Library/PrintLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+
+//
+// Maximum number of samples. At the default 10 ms timer period it covers
+// more than ten minutes of DXE and BDS execution.
+//
+#define SAMPLING_PROFILER_MAX_SAMPLES  SIZE_64KB
+
+//
+// Maximum length of an image name in the profile.
+//
+#define SAMPLING_PROFILER_MAX_NAME_LENGTH  64
+
+//
+// Maximum length of one line of the folded profile:
+// "<Name>;<Name>+0x<16 hex digits> <20 decimal digits>\n"
+//
+#define SAMPLING_PROFILER_MAX_LINE_LENGTH  (SAMPLING_PROFILER_MAX_NAME_LENGTH * 2 + 48)
+
+#if defined (MDE_CPU_IA32)
+#define SAMPLING_PROFILER_ISA  IsaIa32
+#elif defined (MDE_CPU_X64)
+#define SAMPLING_PROFILER_ISA  IsaX64
+#else
+  #error "Unsupported processor type!"
+#endif
+
+EFI_DEBUG_SUPPORT_PROTOCOL  *mDebugSupport;
+UINTN                       *mSamples;
+UINTN                       mSampleCount;
+UINT64                      mDroppedSampleCount;
+
+/**
+  Record the instruction pointer interrupted by the system timer.
+
+  @param SystemContext  The context of the interrupted code.
+**/
+VOID
+EFIAPI
+SamplingProfilerPeriodicCallback (
+  IN OUT EFI_SYSTEM_CONTEXT  SystemContext
+  )
+{
+  if (mSampleCount >= SAMPLING_PROFILER_MAX_SAMPLES) {
+    mDroppedSampleCount++;
+    return;
+  }
+
+ #if defined (MDE_CPU_IA32)
+  mSamples[mSampleCount++] = (UINTN)SystemContext.SystemContextIa32->Eip;
+ #else
+  mSamples[mSampleCount++] = (UINTN)SystemContext.SystemContextX64->Rip;
+ #endif
+}
+
+/**
+  Compare two samples.
+
+  @param Buffer1  Pointer to the first sample.
+  @param Buffer2  Pointer to the second sample.
+
+  @retval 0       Buffer1 equal to Buffer2.
+  @retval <0      Buffer1 is less than Buffer2.
+  @retval >0      Buffer1 is greater than Buffer2.
+**/
+INTN
+EFIAPI
+SamplingProfilerCompareSample (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  if (*(CONST UINTN *)Buffer1 == *(CONST UINTN *)Buffer2) {
+    return 0;
+  }
+
+  return (*(CONST UINTN *)Buffer1 < *(CONST UINTN *)Buffer2) ? -1 : 1;
+}
+
+/**
+  Find the loaded image which contains the address.
+
+  @param DebugImageInfoTable  The Debug Image Info Table header.
+  @param Address              The address to look up.
+
+  @return The loaded image protocol of the image, or NULL if not found.
+**/
+EFI_LOADED_IMAGE_PROTOCOL *
+SamplingProfilerFindImage (
+  IN EFI_DEBUG_IMAGE_INFO_TABLE_HEADER  *DebugImageInfoTable,
+  IN UINTN                              Address
+  )
+{
+  UINTN                      Index;
+  EFI_DEBUG_IMAGE_INFO       *ImageInfo;
+  EFI_LOADED_IMAGE_PROTOCOL  *LoadedImage;
+
+  if ((DebugImageInfoTable == NULL) || (DebugImageInfoTable->EfiDebugImageInfoTable == NULL)) {
+    return NULL;
+  }
+
+  ImageInfo = DebugImageInfoTable->EfiDebugImageInfoTable;
+  for (Index = 0; Index < DebugImageInfoTable->TableSize; Index++) {
+    if ((ImageInfo[Index].NormalImage == NULL) ||
+        (ImageInfo[Index].NormalImage->ImageInfoType != EFI_DEBUG_IMAGE_INFO_TYPE_NORMAL))
+    {
+      continue;
+    }
+
+    LoadedImage = ImageInfo[Index].NormalImage->LoadedImageProtocolInstance;
+    if ((LoadedImage != NULL) &&
+        (Address >= (UINTN)LoadedImage->ImageBase) &&
+        (Address - (UINTN)LoadedImage->ImageBase < LoadedImage->ImageSize))
+    {
+      return LoadedImage;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Get the image name from the PDB file name recorded in the image.
+
+  @param LoadedImage  The loaded image protocol of the image, or NULL.
+  @param Name         Return the NULL-terminated name of the image.
+**/
+VOID
+SamplingProfilerGetImageName (
+  IN  EFI_LOADED_IMAGE_PROTOCOL  *LoadedImage,
+  OUT CHAR8                      Name[SAMPLING_PROFILER_MAX_NAME_LENGTH]
+  )
+{
+  CHAR8  *PdbFileName;
+  UINTN  Start;
+  UINTN  End;
+  UINTN  Index;
+
+  AsciiStrCpyS (Name, SAMPLING_PROFILER_MAX_NAME_LENGTH, "Unknown");
+  if (LoadedImage == NULL) {
+    return;
+  }
+
+  PdbFileName = PeCoffLoaderGetPdbPointer (LoadedImage->ImageBase);
+  if (PdbFileName == NULL) {
+    return;
+  }
+
+  //
+  // Strip the directory and the extension of the PDB file name.
+  //
+  Start = 0;
+  for (Index = 0; PdbFileName[Index] != 0; Index++) {
+    if ((PdbFileName[Index] == '\\') || (PdbFileName[Index] == '/')) {
+      Start = Index + 1;
+    }
+  }
+
+  End = Index;
+  for (Index = Start; PdbFileName[Index] != 0; Index++) {
+    if (PdbFileName[Index] == '.') {
+      End = Index;
+    }
+  }
+
+  if (End - Start >= SAMPLING_PROFILER_MAX_NAME_LENGTH) {
+    End = Start + SAMPLING_PROFILER_MAX_NAME_LENGTH - 1;
+  }
+
+  if (End > Start) {
+    AsciiStrnCpyS (Name, SAMPLING_PROFILER_MAX_NAME_LENGTH, PdbFileName + Start, End - Start);
+  }
+}
+
+/**
+  Stop sampling, and install the folded profile as a configuration table.
+
+  @param Event    The event that is signaled.
+  @param Context  Not used.
+**/
+VOID
+EFIAPI
+SamplingProfilerReadyToBoot (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  EFI_STATUS                         Status;
+  EFI_TIMER_ARCH_PROTOCOL            *Timer;
+  EFI_DEBUG_IMAGE_INFO_TABLE_HEADER  *DebugImageInfoTable;
+  EFI_LOADED_IMAGE_PROTOCOL          *LoadedImage;
+  EDKII_SAMPLING_PROFILE_HEADER      *Header;
+  CHAR8                              *Profile;
+  UINTN                              ProfileSize;
+  UINTN                              UniqueCount;
+  UINTN                              Index;
+  UINTN                              Next;
+  UINTN                              Sample;
+  CHAR8                              Name[SAMPLING_PROFILER_MAX_NAME_LENGTH];
+
+  gBS->CloseEvent (Event);
+
+  mDebugSupport->RegisterPeriodicCallback (mDebugSupport, 0, NULL);
+
+  Status = EfiGetSystemConfigurationTable (&gEfiDebugImageInfoTableGuid, (VOID **)&DebugImageInfoTable);
+  if (EFI_ERROR (Status)) {
+    DebugImageInfoTable = NULL;
+  }
+
+  Sample = 0;
+  QuickSort (mSamples, mSampleCount, sizeof (UINTN), SamplingProfilerCompareSample, &Sample);
+
+  UniqueCount = 0;
+  for (Index = 0; Index < mSampleCount; Index++) {
+    if ((Index == 0) || (mSamples[Index] != mSamples[Index - 1])) {
+      UniqueCount++;
+    }
+  }
+
+  Profile = AllocatePool (UniqueCount * SAMPLING_PROFILER_MAX_LINE_LENGTH + 1);
+  if (Profile == NULL) {
+    FreePool (mSamples);
+    return;
+  }
+
+  ProfileSize = 0;
+  for (Index = 0; Index < mSampleCount; Index = Next) {
+    Next = Index + 1;
+    while ((Next < mSampleCount) && (mSamples[Next] == mSamples[Index])) {
+      Next++;
+    }
+
+    LoadedImage = SamplingProfilerFindImage (DebugImageInfoTable, mSamples[Index]);
+    SamplingProfilerGetImageName (LoadedImage, Name);
+    ProfileSize += AsciiSPrint (
+                     Profile + ProfileSize,
+                     SAMPLING_PROFILER_MAX_LINE_LENGTH + 1,
+                     "%a;%a+0x%lx %Lu\n",
+                     Name,
+                     Name,
+                     (UINT64)(mSamples[Index] - ((LoadedImage == NULL) ? 0 : (UINTN)LoadedImage->ImageBase)),
+                     (UINT64)(Next - Index)
+                     );
+  }
+
+  Profile[ProfileSize++] = '\0';
+
+  Header = AllocateRuntimeZeroPool (sizeof (EDKII_SAMPLING_PROFILE_HEADER) + ProfileSize);
+  if (Header != NULL) {
+    Header->Signature          = EDKII_SAMPLING_PROFILE_SIGNATURE;
+    Header->HeaderLength       = sizeof (EDKII_SAMPLING_PROFILE_HEADER);
+    Header->Revision           = EDKII_SAMPLING_PROFILE_REVISION;
+    Header->SampleCount        = mSampleCount;
+    Header->DroppedSampleCount = mDroppedSampleCount;
+    Header->ProfileSize        = (UINT32)ProfileSize;
+    Status                     = gBS->LocateProtocol (&gEfiTimerArchProtocolGuid, NULL, (VOID **)&Timer);
+    if (!EFI_ERROR (Status)) {
+      Timer->GetTimerPeriod (Timer, &Header->SamplePeriod);
+    }
+
+    CopyMem (Header + 1, Profile, ProfileSize);
+    Status = gBS->InstallConfigurationTable (&gEdkiiSamplingProfileGuid, Header);
+    ASSERT_EFI_ERROR (Status);
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "SamplingProfiler: %Lu samples (%Lu dropped) at %Lu locations\n",
+    (UINT64)mSampleCount,
+    mDroppedSampleCount,
+    (UINT64)UniqueCount
+    ));
+
+  FreePool (Profile);
+  FreePool (mSamples);
+}
+
+/**
+  The driver entry point. Start sampling the system timer interrupts.
+
+  @param ImageHandle  The firmware allocated handle for the EFI image.
+  @param SystemTable  A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS           Sampling is started.
+  @retval EFI_UNSUPPORTED       The Debug Support protocol doesn't support the processor.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate the sample buffer.
+  @retval Others                The periodic callback cannot be registered.
+**/
+EFI_STATUS
+EFIAPI
+SamplingProfilerDxeEntryPoint (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS  Status;
+  EFI_EVENT   ReadyToBootEvent;
+
+  Status = gBS->LocateProtocol (&gEfiDebugSupportProtocolGuid, NULL, (VOID **)&mDebugSupport);
+  ASSERT_EFI_ERROR (Status);
+  if (mDebugSupport->Isa != SAMPLING_PROFILER_ISA) {
+    return EFI_UNSUPPORTED;
+  }
+
+  mSamples = AllocatePool (SAMPLING_PROFILER_MAX_SAMPLES * sizeof (UINTN));
+  if (mSamples == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Status = EfiCreateEventReadyToBootEx (
+             TPL_CALLBACK,
+             SamplingProfilerReadyToBoot,
+             NULL,
+             &ReadyToBootEvent
+             );
+  ASSERT_EFI_ERROR (Status);
+
+  //
+  // The periodic callback fails when it's already owned by a debug agent.
+  //
+  Status = mDebugSupport->RegisterPeriodicCallback (mDebugSupport, 0, SamplingProfilerPeriodicCallback);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "SamplingProfiler: Failed to register periodic callback - %r\n", Status));
+    gBS->CloseEvent (ReadyToBootEvent);
+    FreePool (mSamples);
+    return Status;
+  }
+
+  return EFI_SUCCESS;
+}
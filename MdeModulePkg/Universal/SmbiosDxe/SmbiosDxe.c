@@ -246,7 +246,7 @@ GetSmbiosStructureSize (
 
   Determin whether an SmbiosHandle has already in use.
 
-  @param Head        Pointer to the beginning of SMBIOS structure.
+  @param Private     Pointer to the SMBIOS_INSTANCE.
   @param Handle      A unique handle will be assigned to the SMBIOS record.
 
   @retval TRUE       Smbios handle already in use.
@@ -256,21 +256,34 @@ GetSmbiosStructureSize (
 BOOLEAN
 EFIAPI
 CheckSmbiosHandleExistance (
-  IN  LIST_ENTRY         *Head,
+  IN  SMBIOS_INSTANCE    *Private,
   IN  EFI_SMBIOS_HANDLE  Handle
   )
 {
-  LIST_ENTRY           *Link;
-  SMBIOS_HANDLE_ENTRY  *HandleEntry;
+  return (BOOLEAN)((Private->AllocatedHandleBitmap[Handle / 8] & (1 << (Handle % 8))) != 0);
+}
 
-  for (Link = Head->ForwardLink; Link != Head; Link = Link->ForwardLink) {
-    HandleEntry = SMBIOS_HANDLE_ENTRY_FROM_LINK (Link);
-    if (HandleEntry->SmbiosHandle == Handle) {
-      return TRUE;
-    }
-  }
+/**
+
+  Mark an SmbiosHandle as used or free.
+
+  @param Private     Pointer to the SMBIOS_INSTANCE.
+  @param Handle      The SMBIOS handle.
+  @param InUse       TRUE to mark the handle as used, FALSE to free it.
 
-  return FALSE;
+**/
+VOID
+SetSmbiosHandleExistance (
+  IN  SMBIOS_INSTANCE    *Private,
+  IN  EFI_SMBIOS_HANDLE  Handle,
+  IN  BOOLEAN            InUse
+  )
+{
+  if (InUse) {
+    Private->AllocatedHandleBitmap[Handle / 8] |= (UINT8)(1 << (Handle % 8));
+  } else {
+    Private->AllocatedHandleBitmap[Handle / 8] &= (UINT8) ~(1 << (Handle % 8));
+  }
 }
 
 /**
@@ -313,18 +326,24 @@ GetAvailableSmbiosHandle (
   IN OUT   EFI_SMBIOS_HANDLE    *Handle
   )
 {
-  LIST_ENTRY         *Head;
   SMBIOS_INSTANCE    *Private;
   EFI_SMBIOS_HANDLE  MaxSmbiosHandle;
-  EFI_SMBIOS_HANDLE  AvailableHandle;
+  UINTN              AvailableHandle;
 
   GetMaxSmbiosHandle (This, &MaxSmbiosHandle);
 
   Private = SMBIOS_INSTANCE_FROM_THIS (This);
-  Head    = &Private->AllocatedHandleListHead;
   for (AvailableHandle = 0; AvailableHandle < MaxSmbiosHandle; AvailableHandle++) {
-    if (!CheckSmbiosHandleExistance (Head, AvailableHandle)) {
-      *Handle = AvailableHandle;
+    //
+    // Skip eight handles at a time while they are all in use.
+    //
+    if (((AvailableHandle % 8) == 0) && (Private->AllocatedHandleBitmap[AvailableHandle / 8] == MAX_UINT8)) {
+      AvailableHandle += 7;
+      continue;
+    }
+
+    if (!CheckSmbiosHandleExistance (Private, (EFI_SMBIOS_HANDLE)AvailableHandle)) {
+      *Handle = (EFI_SMBIOS_HANDLE)AvailableHandle;
       return EFI_SUCCESS;
     }
   }
@@ -366,11 +385,9 @@ SmbiosAdd (
   UINTN                     StructureSize;
   UINTN                     NumberOfStrings;
   EFI_STATUS                Status;
-  LIST_ENTRY                *Head;
   SMBIOS_INSTANCE           *Private;
   EFI_SMBIOS_ENTRY          *SmbiosEntry;
   EFI_SMBIOS_HANDLE         MaxSmbiosHandle;
-  SMBIOS_HANDLE_ENTRY       *HandleEntry;
   EFI_SMBIOS_RECORD_HEADER  *InternalRecord;
   BOOLEAN                   Smbios32BitTable;
   BOOLEAN                   Smbios64BitTable;
@@ -383,8 +400,7 @@ SmbiosAdd (
   //
   // Check whether SmbiosHandle is already in use
   //
-  Head = &Private->AllocatedHandleListHead;
-  if ((*SmbiosHandle != SMBIOS_HANDLE_PI_RESERVED) && CheckSmbiosHandleExistance (Head, *SmbiosHandle)) {
+  if ((*SmbiosHandle != SMBIOS_HANDLE_PI_RESERVED) && CheckSmbiosHandleExistance (Private, *SmbiosHandle)) {
     return EFI_ALREADY_STARTED;
   }
 
@@ -479,18 +495,10 @@ SmbiosAdd (
     return EFI_OUT_OF_RESOURCES;
   }
 
-  HandleEntry = AllocateZeroPool (sizeof (SMBIOS_HANDLE_ENTRY));
-  if (HandleEntry == NULL) {
-    EfiReleaseLock (&Private->DataLock);
-    return EFI_OUT_OF_RESOURCES;
-  }
-
   //
-  // Build Handle Entry and insert into linked list
+  // Mark the handle as allocated
   //
-  HandleEntry->Signature    = SMBIOS_HANDLE_ENTRY_SIGNATURE;
-  HandleEntry->SmbiosHandle = *SmbiosHandle;
-  InsertTailList (&Private->AllocatedHandleListHead, &HandleEntry->Link);
+  SetSmbiosHandleExistance (Private, *SmbiosHandle, TRUE);
 
   InternalRecord = (EFI_SMBIOS_RECORD_HEADER *)(SmbiosEntry + 1);
   Raw            = (VOID *)(InternalRecord + 1);
@@ -812,7 +820,6 @@ SmbiosRemove (
   EFI_SMBIOS_HANDLE        MaxSmbiosHandle;
   SMBIOS_INSTANCE          *Private;
   EFI_SMBIOS_ENTRY         *SmbiosEntry;
-  SMBIOS_HANDLE_ENTRY      *HandleEntry;
   EFI_SMBIOS_TABLE_HEADER  *Record;
 
   //
@@ -843,17 +850,9 @@ SmbiosRemove (
       //
       RemoveEntryList (Link);
       //
-      // Remove this handle from AllocatedHandleList
+      // Free this handle
       //
-      Head = &Private->AllocatedHandleListHead;
-      for (Link = Head->ForwardLink; Link != Head; Link = Link->ForwardLink) {
-        HandleEntry = SMBIOS_HANDLE_ENTRY_FROM_LINK (Link);
-        if (HandleEntry->SmbiosHandle == SmbiosHandle) {
-          RemoveEntryList (Link);
-          FreePool (HandleEntry);
-          break;
-        }
-      }
+      SetSmbiosHandleExistance (Private, SmbiosHandle, FALSE);
 
       //
       // Some UEFI drivers (such as network) need some information in SMBIOS table.
@@ -1776,7 +1775,6 @@ SmbiosDriverEntryPoint (
   mPrivateData.Smbios.MinorVersion = (UINT8)(PcdGet16 (PcdSmbiosVersion) & 0x00ff);
 
   InitializeListHead (&mPrivateData.DataListHead);
-  InitializeListHead (&mPrivateData.AllocatedHandleListHead);
   EfiInitializeLock (&mPrivateData.DataLock, TPL_NOTIFY);
 
   //
@@ -545,8 +545,11 @@ Reclaim (
   VARIABLE_HEADER        *UpdatingVariable;
   VARIABLE_HEADER        *UpdatingInDeletedTransition;
   BOOLEAN                AuthFormat;
+  UINTN                  WriteOffset;
+  UINTN                  CompareSize;
 
   AuthFormat                  = mVariableModuleGlobal->VariableGlobal.AuthFormat;
+  WriteOffset                 = 0;
   UpdatingVariable            = NULL;
   UpdatingInDeletedTransition = NULL;
   if (UpdatingPtrTrack != NULL) {
@@ -758,10 +761,36 @@ Reclaim (
     //
     // If non-volatile variable store, perform FTW here.
     //
-    Status = FtwVariableSpace (
-               VariableBase,
-               (VARIABLE_STORE_HEADER *)ValidBuffer
-               );
+    // Variables that precede the first deleted or obsolete one keep their
+    // offsets, so the head of the reclaimed store usually matches the flash.
+    // Only write from the first differing byte on, which lets FTW skip the
+    // unchanged blocks. Nothing is written if reclaim changed nothing.
+    // Compare a chunk at a time first, as the store is memory-mapped flash.
+    //
+    CompareSize = MIN (VARIABLE_RECLAIM_COMPARE_SIZE, VariableStoreHeader->Size);
+    while ((CompareSize != 0) &&
+           (CompareMem (ValidBuffer + WriteOffset, (UINT8 *)(UINTN)VariableBase + WriteOffset, CompareSize) == 0))
+    {
+      WriteOffset += CompareSize;
+      CompareSize  = MIN (VARIABLE_RECLAIM_COMPARE_SIZE, VariableStoreHeader->Size - WriteOffset);
+    }
+
+    while (WriteOffset < VariableStoreHeader->Size &&
+           ValidBuffer[WriteOffset] == ((UINT8 *)(UINTN)VariableBase)[WriteOffset])
+    {
+      WriteOffset++;
+    }
+
+    if (WriteOffset == VariableStoreHeader->Size) {
+      Status = EFI_SUCCESS;
+    } else {
+      Status = FtwVariableSpace (
+                 VariableBase,
+                 (VARIABLE_STORE_HEADER *)ValidBuffer,
+                 WriteOffset
+                 );
+    }
+
     if (!EFI_ERROR (Status)) {
       *LastVariableOffset                                = (UINTN)CurrPtr - (UINTN)ValidBuffer;
       mVariableModuleGlobal->HwErrVariableTotalSize      = HwErrVariableTotalSize;
@@ -804,12 +833,17 @@ Done:
   } else {
     //
     // For NV variable reclaim, we use mNvVariableCache as the buffer, so copy the data back.
+    // The bytes before WriteOffset already match the variable store.
     //
-    CopyMem (mNvVariableCache, (UINT8 *)(UINTN)VariableBase, VariableStoreHeader->Size);
+    CopyMem (
+      (UINT8 *)mNvVariableCache + WriteOffset,
+      (UINT8 *)(UINTN)VariableBase + WriteOffset,
+      VariableStoreHeader->Size - WriteOffset
+      );
     DoneStatus = SynchronizeRuntimeVariableCache (
                    &mVariableModuleGlobal->VariableGlobal.VariableRuntimeCacheContext.VariableRuntimeNvCache,
-                   0,
-                   VariableStoreHeader->Size
+                   WriteOffset,
+                   VariableStoreHeader->Size - WriteOffset
                    );
     ASSERT_EFI_ERROR (DoneStatus);
   }
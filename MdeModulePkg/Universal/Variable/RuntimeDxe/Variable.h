@@ -54,6 +54,11 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 ///
 #define ISO_639_2_ENTRY_SIZE  3
 
+///
+/// The chunk size used by Reclaim() to find the first changed byte.
+///
+#define VARIABLE_RECLAIM_COMPARE_SIZE  SIZE_4KB
+
 typedef enum {
   VariableStoreTypeVolatile,
   VariableStoreTypeHob,
@@ -143,8 +148,13 @@ FlushHobVariableToFlash (
   volume block device. The destination is specified by the parameter
   VariableBase. Fault Tolerant Write protocol is used for writing.
 
+  Only the range from Offset to the end of the store is written; the FTW
+  recovery in InitRealNonVolatileVariableStore() expects a partial write of
+  the variable store to extend to the end of the store.
+
   @param  VariableBase   Base address of the variable to write.
   @param  VariableBuffer Point to the variable data buffer.
+  @param  Offset         Offset in the variable store of the first byte to write.
 
   @retval EFI_SUCCESS    The function completed successfully.
   @retval EFI_NOT_FOUND  Fail to locate Fault Tolerant Write protocol.
@@ -154,7 +164,8 @@ FlushHobVariableToFlash (
 EFI_STATUS
 FtwVariableSpace (
   IN EFI_PHYSICAL_ADDRESS   VariableBase,
-  IN VARIABLE_STORE_HEADER  *VariableBuffer
+  IN VARIABLE_STORE_HEADER  *VariableBuffer,
+  IN UINTN                  Offset
   );
 
 /**
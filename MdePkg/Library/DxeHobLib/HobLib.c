@@ -11,12 +11,31 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Guid/HobList.h>
 
 #include <Library/HobLib.h>
+#include <Library/BaseLib.h>
 #include <Library/UefiLib.h>
 #include <Library/DebugLib.h>
 #include <Library/BaseMemoryLib.h>
 
 VOID  *mHobList = NULL;
 
+//
+// A GUID HOB found from the start of the HOB list stays where it is in the
+// DXE phase, so remember the most recent lookups that found one, so that
+// drivers querying the same GUID repeatedly don't walk the whole HOB list
+// each time. Lookups that found nothing are not remembered, because a HOB
+// could still be added to the list later. An entry with a NULL GuidHob is
+// unused.
+//
+#define GUID_HOB_CACHE_SIZE  8
+
+typedef struct {
+  EFI_GUID    Guid;
+  VOID        *GuidHob;
+} GUID_HOB_CACHE_ENTRY;
+
+GUID_HOB_CACHE_ENTRY  mGuidHobCache[GUID_HOB_CACHE_SIZE];
+UINTN                 mGuidHobCacheNext = 0;
+
 /**
   Returns the pointer to the HOB list.
 
@@ -172,6 +191,18 @@ GetNextGuidHob (
   )
 {
   EFI_PEI_HOB_POINTERS  GuidHob;
+  UINTN                 Index;
+  BOOLEAN               FromListStart;
+
+  FromListStart = (BOOLEAN)(HobStart == mHobList);
+  if (FromListStart) {
+    for (Index = 0; Index < GUID_HOB_CACHE_SIZE; Index++) {
+      GuidHob.Raw = mGuidHobCache[Index].GuidHob;
+      if ((GuidHob.Raw != NULL) && CompareGuid (Guid, &mGuidHobCache[Index].Guid)) {
+        return GuidHob.Raw;
+      }
+    }
+  }
 
   GuidHob.Raw = (UINT8 *)HobStart;
   while ((GuidHob.Raw = GetNextHob (EFI_HOB_TYPE_GUID_EXTENSION, GuidHob.Raw)) != NULL) {
@@ -182,6 +213,22 @@ GetNextGuidHob (
     GuidHob.Raw = GET_NEXT_HOB (GuidHob);
   }
 
+  if (FromListStart && (GuidHob.Raw != NULL)) {
+    //
+    // Claim the entry before filling it, and keep it unused while the GUID is
+    // written, so that a nested call from a higher TPL neither picks the same
+    // entry nor matches the new GUID with the old HOB pointer.
+    //
+    Index             = mGuidHobCacheNext;
+    mGuidHobCacheNext = (Index + 1) % GUID_HOB_CACHE_SIZE;
+
+    mGuidHobCache[Index].GuidHob = NULL;
+    MemoryFence ();
+    CopyGuid (&mGuidHobCache[Index].Guid, Guid);
+    MemoryFence ();
+    mGuidHobCache[Index].GuidHob = GuidHob.Raw;
+  }
+
   return GuidHob.Raw;
 }
 
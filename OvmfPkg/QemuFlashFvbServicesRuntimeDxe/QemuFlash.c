@@ -19,15 +19,32 @@
 #define CLEAR_STATUS_CMD         0x50
 #define READ_STATUS_CMD          0x70
 #define READ_DEVID_CMD           0x90
+#define CFI_QUERY_CMD            0x98
 #define BLOCK_ERASE_CONFIRM_CMD  0xd0
+#define WRITE_BUFFER_CMD         0xe8
+#define WRITE_BUFFER_CONFIRM_CMD 0xd0
 #define READ_ARRAY_CMD           0xff
 
 #define CLEARED_ARRAY_STATUS  0x00
+#define READY_STATUS          0x80
+
+//
+// CFI query offsets, in bytes on the 8-bit QEMU flash device
+//
+#define CFI_QUERY_UNIQUE_QRY_STRING    0x10
+#define CFI_QUERY_MAX_BUFFER_SIZE_EXP  0x2A
+
+//
+// Log2 of the largest chunk programmed with a single Write to Buffer command.
+// The word count is one byte wide on the 8-bit QEMU flash device.
+//
+#define WRITE_BUFFER_SIZE_EXP  8
 
 UINT8  *mFlashBase;
 
-STATIC UINTN  mFdBlockSize  = 0;
-STATIC UINTN  mFdBlockCount = 0;
+STATIC UINTN  mFdBlockSize          = 0;
+STATIC UINTN  mFdBlockCount         = 0;
+STATIC UINTN  mFlashWriteBufferSize = 0;
 
 STATIC
 volatile UINT8 *
@@ -39,6 +56,83 @@ QemuFlashPtr (
   return mFlashBase + ((UINTN)Lba * mFdBlockSize) + Offset;
 }
 
+/**
+  Program bytes with a single Write to Buffer command. This takes one MMIO
+  write per byte plus three, instead of two MMIO writes per byte for the
+  Byte Program command.
+
+  The bytes must not cross a mFlashWriteBufferSize aligned boundary. The
+  device is left in status mode.
+
+  @param[in] Ptr      Pointer to the first flash location to program.
+  @param[in] Length   Number of bytes to program, 1 to mFlashWriteBufferSize.
+  @param[in] Buffer   Pointer to the data to program.
+
+**/
+STATIC
+VOID
+QemuFlashWriteBuffer (
+  IN        volatile UINT8  *Ptr,
+  IN        UINTN           Length,
+  IN CONST  UINT8           *Buffer
+  )
+{
+  UINTN  Loop;
+
+  QemuFlashPtrWrite (Ptr, WRITE_BUFFER_CMD);
+  QemuFlashPtrWrite (Ptr, (UINT8)(Length - 1));
+  for (Loop = 0; Loop < Length; Loop++) {
+    QemuFlashPtrWrite (Ptr + Loop, Buffer[Loop]);
+  }
+
+  QemuFlashPtrWrite (Ptr, WRITE_BUFFER_CONFIRM_CMD);
+}
+
+/**
+  Check whether the flash device implements the Write to Buffer command, and
+  how many bytes it accepts at once, with a CFI query. The query only changes
+  the read mode of the device; nothing is programmed or erased.
+
+  This is only called for a device that QemuFlashDetected () found to behave
+  as writable flash, and that is in read array mode. A device that does not
+  implement the query keeps returning array data, which does not hold the
+  "QRY" string at the probed offsets, so Write to Buffer is not used. The
+  device is returned to read array mode on every path.
+
+**/
+STATIC
+VOID
+QemuFlashProbeWriteBuffer (
+  VOID
+  )
+{
+  volatile UINT8  *Ptr;
+  UINT8           SizeExp;
+
+  Ptr  = QemuFlashPtr (0, 0);
+  *Ptr = CFI_QUERY_CMD;
+  if ((Ptr[CFI_QUERY_UNIQUE_QRY_STRING] == 'Q') &&
+      (Ptr[CFI_QUERY_UNIQUE_QRY_STRING + 1] == 'R') &&
+      (Ptr[CFI_QUERY_UNIQUE_QRY_STRING + 2] == 'Y'))
+  {
+    //
+    // A zero exponent means the device has no write buffer.
+    //
+    SizeExp = Ptr[CFI_QUERY_MAX_BUFFER_SIZE_EXP];
+    if (SizeExp != 0) {
+      mFlashWriteBufferSize = (UINTN)1 << MIN (SizeExp, WRITE_BUFFER_SIZE_EXP);
+    }
+  }
+
+  *Ptr = READ_ARRAY_CMD;
+
+  DEBUG ((
+    DEBUG_INFO,
+    "QemuFlashDetected => Write to Buffer size %Lu\n",
+    (UINT64)mFlashWriteBufferSize
+    ));
+}
+
 /**
   Determines if the QEMU flash memory device is present.
 
@@ -124,6 +218,7 @@ QemuFlashDetected (
       } else {
         DEBUG ((DEBUG_INFO, "QemuFlashDetected => FD behaves as FLASH, writable\n"));
         FlashDetected = TRUE;
+        QemuFlashProbeWriteBuffer ();
       }
     }
   }
@@ -193,7 +288,9 @@ QemuFlashWrite (
   )
 {
   volatile UINT8  *Ptr;
-  UINTN           Loop;
+  UINTN           First;
+  UINTN           Last;
+  UINTN           Length;
 
   //
   // Only write to the first 64k. We don't bother saving the FTW Spare
@@ -204,23 +301,42 @@ QemuFlashWrite (
   }
 
   //
-  // Program flash
+  // The flash is in read array mode, where reading it does not trap to the
+  // hypervisor. Only program the range of bytes that actually change.
   //
   Ptr = QemuFlashPtr (Lba, Offset);
-  for (Loop = 0; Loop < *NumBytes; Loop++) {
-    QemuFlashPtrWrite (Ptr, WRITE_BYTE_CMD);
-    QemuFlashPtrWrite (Ptr, Buffer[Loop]);
+  for (First = 0; (First < *NumBytes) && (Ptr[First] == Buffer[First]); First++) {
+  }
+
+  if (First == *NumBytes) {
+    return EFI_SUCCESS;
+  }
 
-    Ptr++;
+  for (Last = *NumBytes; Ptr[Last - 1] == Buffer[Last - 1]; Last--) {
   }
 
   //
-  // Restore flash to read mode
+  // Program flash
   //
-  if (*NumBytes > 0) {
-    QemuFlashPtrWrite (Ptr - 1, READ_ARRAY_CMD);
+  while (First < Last) {
+    if (mFlashWriteBufferSize != 0) {
+      Length = mFlashWriteBufferSize - ((UINTN)(Ptr + First) & (mFlashWriteBufferSize - 1));
+      Length = MIN (Length, Last - First);
+      QemuFlashWriteBuffer (Ptr + First, Length, Buffer + First);
+    } else {
+      Length = 1;
+      QemuFlashPtrWrite (Ptr + First, WRITE_BYTE_CMD);
+      QemuFlashPtrWrite (Ptr + First, Buffer[First]);
+    }
+
+    First += Length;
   }
 
+  //
+  // Restore flash to read mode
+  //
+  QemuFlashPtrWrite (Ptr + Last - 1, READ_ARRAY_CMD);
+
   return EFI_SUCCESS;
 }
 
@@ -236,14 +352,30 @@ QemuFlashEraseBlock (
   )
 {
   volatile UINT8  *Ptr;
+  UINTN           Loop;
 
   if (Lba >= mFdBlockCount) {
     return EFI_INVALID_PARAMETER;
   }
 
+  //
+  // Leave the block alone if it is erased already.
+  //
   Ptr = QemuFlashPtr (Lba, 0);
+  for (Loop = 0; (Loop < mFdBlockSize) && (Ptr[Loop] == 0xff); Loop++) {
+  }
+
+  if (Loop == mFdBlockSize) {
+    return EFI_SUCCESS;
+  }
+
   QemuFlashPtrWrite (Ptr, BLOCK_ERASE_CMD);
   QemuFlashPtrWrite (Ptr, BLOCK_ERASE_CONFIRM_CMD);
+
+  //
+  // Restore flash to read mode
+  //
+  QemuFlashPtrWrite (Ptr, READ_ARRAY_CMD);
   return EFI_SUCCESS;
 }
 
@@ -520,6 +520,8 @@ NorFlashWriteSingleBlock (
   UINTN       BlockSize;
   UINTN       BlockAddress;
   UINT8       *OrigData;
+  UINTN       ProgramSize;
+  BOOLEAN     Changed;
 
   DEBUG ((DEBUG_BLKIO, "NorFlashWriteSingleBlock(Parameters: Lba=%ld, Offset=0x%x, *NumBytes=0x%x, Buffer @ 0x%08x)\n", Lba, Offset, *NumBytes, Buffer));
 
@@ -580,14 +582,27 @@ NorFlashWriteSingleBlock (
     // Update the buffer containing the old version of the data with the new
     // contents, while checking whether the old version had any bits cleared
     // that we want to set. In that case, we will need to erase the block first.
+    Changed = FALSE;
     for (CurOffset = 0; CurOffset < *NumBytes; CurOffset++) {
       if (~OrigData[CurOffset] & Buffer[CurOffset]) {
         goto DoErase;
       }
 
-      OrigData[CurOffset] = Buffer[CurOffset];
+      if (OrigData[CurOffset] != Buffer[CurOffset]) {
+        OrigData[CurOffset] = Buffer[CurOffset];
+        Changed             = TRUE;
+      }
+    }
+
+    // Nothing to do if the flash already holds the data
+    if (!Changed) {
+      return EFI_SUCCESS;
     }
 
+    // Only program the words up to the end of the new data. The words in
+    // front of it hold their current value, which programs as a no-op.
+    ProgramSize = ALIGN_VALUE (*NumBytes + (Offset & BOUNDARY_OF_32_WORDS), 4);
+
     //
     // Write the updated buffer to NOR.
     //
@@ -602,20 +617,20 @@ NorFlashWriteSingleBlock (
     Status = NorFlashWriteBuffer (
                Instance,
                BlockAddress + (Offset & ~BOUNDARY_OF_32_WORDS),
-               P30_MAX_BUFFER_SIZE_IN_BYTES,
+               MIN (ProgramSize, P30_MAX_BUFFER_SIZE_IN_BYTES),
                Instance->ShadowBuffer
                );
     if (EFI_ERROR (Status)) {
       goto Exit;
     }
 
-    if ((*NumBytes + (Offset & BOUNDARY_OF_32_WORDS)) > P30_MAX_BUFFER_SIZE_IN_BYTES) {
+    if (ProgramSize > P30_MAX_BUFFER_SIZE_IN_BYTES) {
       BlockAddress += P30_MAX_BUFFER_SIZE_IN_BYTES;
 
       Status = NorFlashWriteBuffer (
                  Instance,
                  BlockAddress + (Offset & ~BOUNDARY_OF_32_WORDS),
-                 P30_MAX_BUFFER_SIZE_IN_BYTES,
+                 ProgramSize - P30_MAX_BUFFER_SIZE_IN_BYTES,
                  Instance->ShadowBuffer + P30_MAX_BUFFER_SIZE_IN_BYTES
                  );
     }
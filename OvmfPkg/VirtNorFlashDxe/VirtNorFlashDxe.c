@@ -137,8 +137,35 @@ NorFlashCreateInstance (
   return Status;
 }
 
+/**
+ * Check whether an entire NOR Flash block is erased, i.e. set to all 1s.
+ **/
+STATIC
+BOOLEAN
+NorFlashBlockIsErased (
+  IN NOR_FLASH_INSTANCE  *Instance,
+  IN UINTN               BlockAddress
+  )
+{
+  CONST UINT32  *Data;
+  UINTN         Index;
+
+  // Put device back into Read Array mode
+  SEND_NOR_COMMAND (Instance->DeviceBaseAddress, 0, P30_CMD_READ_ARRAY);
+
+  Data = (CONST UINT32 *)BlockAddress;
+  for (Index = 0; Index < Instance->BlockSize / 4; Index++) {
+    if (~Data[Index] != 0) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
 /**
  * This function unlock and erase an entire NOR Flash block.
+ * A block that is already erased is left alone.
  **/
 EFI_STATUS
 NorFlashUnlockAndEraseSingleBlock (
@@ -159,6 +186,13 @@ NorFlashUnlockAndEraseSingleBlock (
     OriginalTPL = TPL_HIGH_LEVEL;
   }
 
+  if (NorFlashBlockIsErased (Instance, BlockAddress)) {
+    // The caller may program the block next, so it must still be unlocked
+    Status = NorFlashUnlockSingleBlockIfNecessary (Instance, BlockAddress);
+    SEND_NOR_COMMAND (Instance->DeviceBaseAddress, 0, P30_CMD_READ_ARRAY);
+    goto EXIT;
+  }
+
   Index = 0;
   // The block erase might fail a first time (SW bug ?). Retry it ...
   do {
@@ -176,6 +210,7 @@ NorFlashUnlockAndEraseSingleBlock (
     DEBUG ((DEBUG_ERROR, "EraseSingleBlock(BlockAddress=0x%08x: Block Locked Error (try to erase %d times)\n", BlockAddress, Index));
   }
 
+EXIT:
   if (!EfiAtRuntime ()) {
     // Interruptions can resume.
     gBS->RestoreTPL (OriginalTPL);
@@ -192,15 +227,16 @@ NorFlashWriteFullBlock (
   IN UINT32              BlockSizeInWords
   )
 {
-  EFI_STATUS  Status;
-  UINTN       WordAddress;
-  UINT32      WordIndex;
-  UINTN       BufferIndex;
-  UINTN       BlockAddress;
-  UINTN       BuffersInBlock;
-  UINTN       RemainingWords;
-  EFI_TPL     OriginalTPL;
-  UINTN       Cnt;
+  EFI_STATUS    Status;
+  UINTN         WordAddress;
+  UINT32        WordIndex;
+  UINTN         BufferIndex;
+  UINTN         BlockAddress;
+  UINTN         BuffersInBlock;
+  UINTN         RemainingWords;
+  EFI_TPL       OriginalTPL;
+  CONST UINT32  *FlashData;
+  BOOLEAN       NeedErase;
 
   Status = EFI_SUCCESS;
 
@@ -219,12 +255,39 @@ NorFlashWriteFullBlock (
     OriginalTPL = TPL_HIGH_LEVEL;
   }
 
-  Status = NorFlashUnlockAndEraseSingleBlock (Instance, BlockAddress);
+  // Compare the new data with the current content of the block. Reading the
+  // flash in Read Array mode does not trap to the hypervisor, while every
+  // erase or program command does.
+  SEND_NOR_COMMAND (Instance->DeviceBaseAddress, 0, P30_CMD_READ_ARRAY);
+  FlashData = (CONST UINT32 *)BlockAddress;
+
+  if (CompareMem (FlashData, DataBuffer, BlockSizeInWords * 4) == 0) {
+    goto EXIT;
+  }
+
+  // The block only needs to be erased if some bit must go from 0 to 1
+  NeedErase = FALSE;
+  for (WordIndex = 0; WordIndex < BlockSizeInWords; WordIndex++) {
+    if ((~FlashData[WordIndex] & DataBuffer[WordIndex]) != 0) {
+      NeedErase = TRUE;
+      break;
+    }
+  }
+
+  if (NeedErase) {
+    Status = NorFlashUnlockAndEraseSingleBlock (Instance, BlockAddress);
+  } else {
+    Status = NorFlashUnlockSingleBlockIfNecessary (Instance, BlockAddress);
+  }
+
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "WriteSingleBlock: ERROR - Failed to Unlock and Erase the single block at 0x%X\n", BlockAddress));
     goto EXIT;
   }
 
+  // Put device back into Read Array mode, for the comparisons below
+  SEND_NOR_COMMAND (Instance->DeviceBaseAddress, 0, P30_CMD_READ_ARRAY);
+
   // To speed up the programming operation, NOR Flash is programmed using the Buffered Programming method.
 
   // Check that the address starts at a 32-word boundary, i.e. last 7 bits must be zero
@@ -233,35 +296,34 @@ NorFlashWriteFullBlock (
     BuffersInBlock = (UINTN)(BlockSizeInWords * 4) / P30_MAX_BUFFER_SIZE_IN_BYTES;
 
     // Then feed each buffer chunk to the NOR Flash
-    // If a buffer does not contain any data, don't write it.
+    // If the flash already holds the data of a buffer, e.g. all 1s after
+    // the erase, don't write it.
     for (BufferIndex = 0;
          BufferIndex < BuffersInBlock;
          BufferIndex++, WordAddress += P30_MAX_BUFFER_SIZE_IN_BYTES, DataBuffer += P30_MAX_BUFFER_SIZE_IN_WORDS
          )
     {
-      // Check the buffer to see if it contains any data (not set all 1s).
-      for (Cnt = 0; Cnt < P30_MAX_BUFFER_SIZE_IN_WORDS; Cnt++) {
-        if (~DataBuffer[Cnt] != 0 ) {
-          // Some data found, write the buffer.
-          Status = NorFlashWriteBuffer (
-                     Instance,
-                     WordAddress,
-                     P30_MAX_BUFFER_SIZE_IN_BYTES,
-                     DataBuffer
-                     );
-          if (EFI_ERROR (Status)) {
-            goto EXIT;
-          }
-
-          break;
-        }
+      if (CompareMem ((VOID *)WordAddress, DataBuffer, P30_MAX_BUFFER_SIZE_IN_BYTES) == 0) {
+        continue;
       }
+
+      Status = NorFlashWriteBuffer (
+                 Instance,
+                 WordAddress,
+                 P30_MAX_BUFFER_SIZE_IN_BYTES,
+                 DataBuffer
+                 );
+      if (EFI_ERROR (Status)) {
+        goto EXIT;
+      }
+
+      SEND_NOR_COMMAND (Instance->DeviceBaseAddress, 0, P30_CMD_READ_ARRAY);
     }
 
     // Finally, finish off any remaining words that are less than the maximum size of the buffer
     RemainingWords = BlockSizeInWords % P30_MAX_BUFFER_SIZE_IN_WORDS;
 
-    if (RemainingWords != 0) {
+    if ((RemainingWords != 0) && (CompareMem ((VOID *)WordAddress, DataBuffer, RemainingWords * 4) != 0)) {
       Status = NorFlashWriteBuffer (Instance, WordAddress, (RemainingWords * 4), DataBuffer);
       if (EFI_ERROR (Status)) {
         goto EXIT;
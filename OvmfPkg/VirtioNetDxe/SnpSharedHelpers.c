@@ -8,7 +8,9 @@
 
 **/
 
+#include <Library/BaseLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/SynchronizationLib.h>
 
 #include "VirtioNet.h"
 
@@ -103,6 +105,50 @@ VirtioNetUninitRing (
   VirtioRingUninit (Dev->VirtIo, Ring);
 }
 
+/**
+  Notify the device about new available buffers on a queue, unless the device
+  has asked not to be notified.
+
+  virtio-0.9.5, 2.4.1.4 Notifying the Device: the device sets
+  VRING_USED_F_NO_NOTIFY while it is processing the ring on its own, and a
+  notification would only cause a needless VM exit.
+
+  The caller is responsible for publishing the new available index before
+  calling this function.
+
+  @param[in] Dev         The VNET_DEV driver instance owning the queue.
+  @param[in] Ring        The virtio ring whose available index was advanced.
+  @param[in] QueueIndex  The queue to notify, VIRTIO_NET_Q_RX or
+                         VIRTIO_NET_Q_TX.
+
+  @retval EFI_SUCCESS  The device was notified, or it did not want to be.
+  @return              Status codes from VIRTIO_DEVICE_PROTOCOL.SetQueueNotify().
+*/
+EFI_STATUS
+EFIAPI
+VirtioNetNotifyQueue (
+  IN VNET_DEV  *Dev,
+  IN VRING     *Ring,
+  IN UINT16    QueueIndex
+  )
+{
+  volatile UINT32  Barrier;
+
+  //
+  // The available index must be visible to the device before we sample the
+  // flags it may have set in response. MemoryFence() does not order a store
+  // against a later load on IA32 and X64, so use a locked instruction as a
+  // full barrier.
+  //
+  Barrier = 0;
+  InterlockedCompareExchange32 (&Barrier, 0, 0);
+  if ((*Ring->Used.Flags & VRING_USED_F_NO_NOTIFY) != 0) {
+    return EFI_SUCCESS;
+  }
+
+  return Dev->VirtIo->SetQueueNotify (Dev->VirtIo, QueueIndex);
+}
+
 /**
   Map Caller-supplied TxBuf buffer to the device-mapped address
 
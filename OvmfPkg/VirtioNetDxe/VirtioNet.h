@@ -27,7 +27,7 @@
 //
 // maximum number of pending packets, separately for each direction
 //
-#define VNET_MAX_PENDING  64
+#define VNET_MAX_PENDING  128
 
 //
 // State diagram:
@@ -275,6 +275,14 @@ VirtioNetUninitRing (
   IN     VOID      *RingMap
   );
 
+EFI_STATUS
+EFIAPI
+VirtioNetNotifyQueue (
+  IN VNET_DEV  *Dev,
+  IN VRING     *Ring,
+  IN UINT16    QueueIndex
+  );
+
 //
 // utility functions to map caller-supplied Tx buffer system physical address
 // to a device address and vice versa
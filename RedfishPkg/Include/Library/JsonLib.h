@@ -89,6 +89,51 @@ typedef enum {
   EdkiiJsonTypeNull
 } EDKII_JSON_TYPE;
 
+///
+/// Tokens reported by JsonParseStream()
+///
+typedef enum {
+  EdkiiJsonStreamObjectBegin,
+  EdkiiJsonStreamObjectEnd,
+  EdkiiJsonStreamArrayBegin,
+  EdkiiJsonStreamArrayEnd,
+  EdkiiJsonStreamKey,
+  EdkiiJsonStreamString,
+  EdkiiJsonStreamInteger,
+  EdkiiJsonStreamTrue,
+  EdkiiJsonStreamFalse,
+  EdkiiJsonStreamNull
+} EDKII_JSON_STREAM_EVENT;
+
+/**
+  Callback of JsonParseStream(), called once for every token of the payload.
+
+  @param[in]   Event          The token type.
+  @param[in]   String         UTF-8 bytes of the key or string for
+                              EdkiiJsonStreamKey and EdkiiJsonStreamString,
+                              NULL otherwise. It is not NULL terminated and is
+                              only valid during this call.
+  @param[in]   StringLength   Length of String in bytes.
+  @param[in]   Integer        Value for EdkiiJsonStreamInteger.
+  @param[in]   Depth          Number of containers enclosing this token. The
+                              root object or array has depth 0.
+  @param[in]   Context        Context passed to JsonParseStream().
+
+  @retval      EFI_SUCCESS    Continue parsing.
+  @retval      Others         Stop parsing. JsonParseStream() returns this
+                              status.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_JSON_STREAM_CALLBACK)(
+  IN  EDKII_JSON_STREAM_EVENT  Event,
+  IN  CONST CHAR8              *String,
+  IN  UINTN                    StringLength,
+  IN  EDKII_JSON_INT_T         Integer,
+  IN  UINTN                    Depth,
+  IN  VOID                     *Context
+  );
+
 /**
   The function is used to initialize a JSON value which contains a new JSON array,
   or NULL on error. Initially, the array is empty.
@@ -928,4 +973,38 @@ JsonGetType (
   IN EDKII_JSON_VALUE  JsonValue
   );
 
+/**
+  Parse a JSON text and report each token to the given callback, without
+  building a JSON value tree. The root value must be an object or an array.
+
+  Keys and strings are passed to the callback as UTF-8 byte sequences that
+  are not NULL terminated and are valid only during the callback. Real
+  numbers are not supported.
+
+  @param[in]      Buffer      Buffer of the JSON payload.
+  @param[in]      BufferLen   Length of the buffer in bytes.
+  @param[in]      Callback    Function called for every token.
+  @param[in]      Context     Context passed to Callback.
+  @param[out]     Error       Optional pointer to receive the position and
+                              description of a parse error.
+
+  @retval EFI_SUCCESS             The whole payload is parsed.
+  @retval EFI_INVALID_PARAMETER   Buffer or Callback is NULL, or the payload
+                                  is malformed.
+  @retval EFI_UNSUPPORTED         The payload contains a real number.
+  @retval EFI_OUT_OF_RESOURCES    System is out of memory.
+  @retval Others                  The error returned by Callback, which stops
+                                  the parsing.
+
+**/
+EFI_STATUS
+EFIAPI
+JsonParseStream (
+  IN     CONST CHAR8                 *Buffer,
+  IN     UINTN                       BufferLen,
+  IN     EDKII_JSON_STREAM_CALLBACK  Callback,
+  IN     VOID                        *Context,
+  OUT    EDKII_JSON_ERROR            *Error  OPTIONAL
+  );
+
 #endif
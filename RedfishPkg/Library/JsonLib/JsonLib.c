@@ -938,11 +938,36 @@ JsonDumpString (
   IN    UINTN             Flags
   )
 {
+  CHAR8  *String;
+  UINTN  Size;
+
   if (JsonValue == NULL) {
     return NULL;
   }
 
-  return json_dumps ((json_t *)JsonValue, Flags);
+  //
+  // json_dumps() grows an intermediate buffer while encoding and then copies
+  // the result into another one. Query the encoded size first instead, so the
+  // payload is written once into a buffer of the exact size.
+  //
+  Size = json_dumpb ((json_t *)JsonValue, NULL, 0, Flags);
+  if (Size == 0) {
+    return NULL;
+  }
+
+  String = AllocatePool (Size + 1);
+  if (String == NULL) {
+    return NULL;
+  }
+
+  if (json_dumpb ((json_t *)JsonValue, String, Size, Flags) != Size) {
+    FreePool (String);
+    return NULL;
+  }
+
+  String[Size] = '\0';
+
+  return String;
 }
 
 /**
@@ -0,0 +1,698 @@
+/** @file
+  Streaming JSON parser.
+
+  JsonParseStream() walks a JSON text once and reports every token to a
+  callback instead of building a jansson value tree. Keys and strings are
+  passed in place when they contain no escape sequences, so a payload can be
+  consumed without allocating memory per value.
+
+  Strings are checked to be valid UTF-8 with the same rules as the jansson
+  decoder behind JsonLoadBuffer(), so both accept and reject the same
+  payloads, except that real numbers are not supported here.
+
+    SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/JsonLib.h>
+#include <Library/MemoryAllocationLib.h>
+
+#define JSON_STREAM_MAX_DEPTH  2048
+
+typedef struct {
+  CONST CHAR8                   *Buffer;
+  UINTN                         Length;
+  UINTN                         Position;
+  UINTN                         Line;
+  UINTN                         LineStart;
+  EDKII_JSON_STREAM_CALLBACK    Callback;
+  VOID                          *Context;
+  EDKII_JSON_ERROR              *Error;
+  CHAR8                         *Scratch;     // Buffer to unescape strings.
+  UINTN                         ScratchSize;
+  UINTN                         Depth;
+  UINT8                         IsObject[JSON_STREAM_MAX_DEPTH / 8];
+} JSON_STREAM_PARSER;
+
+/**
+  Record a parse error at the current position.
+
+  @param[in]  Parser    Parser instance.
+  @param[in]  Status    Status to be returned.
+  @param[in]  Text      Error description.
+
+  @retval     Status.
+
+**/
+EFI_STATUS
+JsonStreamError (
+  IN JSON_STREAM_PARSER  *Parser,
+  IN EFI_STATUS          Status,
+  IN CONST CHAR8         *Text
+  )
+{
+  if (Parser->Error != NULL) {
+    ZeroMem (Parser->Error, sizeof (EDKII_JSON_ERROR));
+    Parser->Error->Line     = (INTN)Parser->Line;
+    Parser->Error->Column   = (INTN)(Parser->Position - Parser->LineStart + 1);
+    Parser->Error->Position = (INTN)Parser->Position;
+    AsciiStrCpyS (Parser->Error->Source, EDKII_JSON_ERROR_SOURCE_LENGTH, "<buffer>");
+    AsciiStrCpyS (Parser->Error->Text, EDKII_JSON_ERROR_TEXT_LENGTH, Text);
+  }
+
+  return Status;
+}
+
+/**
+  Skip white spaces and keep track of the line number.
+
+  @param[in]  Parser    Parser instance.
+
+**/
+VOID
+JsonStreamSkipWhiteSpace (
+  IN JSON_STREAM_PARSER  *Parser
+  )
+{
+  CHAR8  Char;
+
+  while (Parser->Position < Parser->Length) {
+    Char = Parser->Buffer[Parser->Position];
+    if (Char == '\n') {
+      Parser->Line++;
+      Parser->LineStart = Parser->Position + 1;
+    } else if ((Char != ' ') && (Char != '\t') && (Char != '\r')) {
+      break;
+    }
+
+    Parser->Position++;
+  }
+}
+
+/**
+  Convert four hexadecimal digits to a UTF-16 code unit.
+
+  @param[in]  Digits    Pointer to the four digits.
+  @param[out] CodeUnit  The converted code unit.
+
+  @retval     TRUE      The digits are converted.
+  @retval     FALSE     There is an invalid digit.
+
+**/
+BOOLEAN
+JsonStreamDecodeHex (
+  IN  CONST CHAR8  *Digits,
+  OUT UINT32       *CodeUnit
+  )
+{
+  UINTN  Index;
+  CHAR8  Char;
+
+  *CodeUnit = 0;
+  for (Index = 0; Index < 4; Index++) {
+    Char      = Digits[Index];
+    *CodeUnit = *CodeUnit << 4;
+    if ((Char >= '0') && (Char <= '9')) {
+      *CodeUnit |= (UINT32)(Char - '0');
+    } else if ((Char >= 'a') && (Char <= 'f')) {
+      *CodeUnit |= (UINT32)(Char - 'a' + 10);
+    } else if ((Char >= 'A') && (Char <= 'F')) {
+      *CodeUnit |= (UINT32)(Char - 'A' + 10);
+    } else {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+  Check the UTF-8 sequence that starts with a byte of 0x80 or above.
+
+  Overlong encodings, UTF-16 surrogates and code points above 0x10FFFF are
+  invalid, as in the jansson decoder.
+
+  @param[in]  Buffer    The first byte of the sequence.
+  @param[in]  Length    Number of bytes available at Buffer.
+
+  @return     The length of the sequence in bytes, or 0 if it is invalid.
+
+**/
+UINTN
+JsonStreamCheckUtf8 (
+  IN CONST CHAR8  *Buffer,
+  IN UINTN        Length
+  )
+{
+  UINT8   Byte;
+  UINTN   Count;
+  UINTN   Index;
+  UINT32  CodePoint;
+
+  Byte = (UINT8)Buffer[0];
+  if ((Byte >= 0xC2) && (Byte <= 0xDF)) {
+    Count     = 2;
+    CodePoint = Byte & 0x1F;
+  } else if ((Byte >= 0xE0) && (Byte <= 0xEF)) {
+    Count     = 3;
+    CodePoint = Byte & 0x0F;
+  } else if ((Byte >= 0xF0) && (Byte <= 0xF4)) {
+    Count     = 4;
+    CodePoint = Byte & 0x07;
+  } else {
+    //
+    // A continuation byte, an overlong two byte sequence, or a sequence that
+    // would encode a code point above 0x10FFFF.
+    //
+    return 0;
+  }
+
+  if (Count > Length) {
+    return 0;
+  }
+
+  for (Index = 1; Index < Count; Index++) {
+    Byte = (UINT8)Buffer[Index];
+    if ((Byte < 0x80) || (Byte > 0xBF)) {
+      return 0;
+    }
+
+    CodePoint = (CodePoint << 6) | (Byte & 0x3F);
+  }
+
+  if ((CodePoint > 0x10FFFF) ||
+      ((CodePoint >= 0xD800) && (CodePoint <= 0xDFFF)) ||
+      ((Count == 3) && (CodePoint < 0x800)) ||
+      ((Count == 4) && (CodePoint < 0x10000)))
+  {
+    return 0;
+  }
+
+  return Count;
+}
+
+/**
+  Parse a string token. The string is returned in place when it contains no
+  escape sequences. Otherwise it is unescaped into the scratch buffer of the
+  parser.
+
+  @param[in]  Parser        Parser instance. Position is at the opening quote.
+  @param[out] String        The UTF-8 string, not NULL terminated.
+  @param[out] StringLength  Length of String in bytes.
+
+  @retval EFI_SUCCESS             The string is parsed.
+  @retval EFI_INVALID_PARAMETER   The string is malformed or is not valid
+                                  UTF-8.
+  @retval EFI_OUT_OF_RESOURCES    System is out of memory.
+
+**/
+EFI_STATUS
+JsonStreamParseString (
+  IN  JSON_STREAM_PARSER  *Parser,
+  OUT CONST CHAR8         **String,
+  OUT UINTN               *StringLength
+  )
+{
+  UINTN        Start;
+  UINTN        End;
+  BOOLEAN      Escaped;
+  CONST CHAR8  *Source;
+  CHAR8        *Target;
+  UINT32       CodePoint;
+  UINT32       LowSurrogate;
+  UINTN        Count;
+
+  Start   = Parser->Position + 1;
+  Escaped = FALSE;
+
+  //
+  // Find the closing quote first so that the unescaped string, which is never
+  // longer than the escaped one, fits into the scratch buffer.
+  //
+  for (End = Start; End < Parser->Length; End++) {
+    if (Parser->Buffer[End] == '"') {
+      break;
+    }
+
+    if ((UINT8)Parser->Buffer[End] < 0x20) {
+      Parser->Position = End;
+      return JsonStreamError (Parser, EFI_INVALID_PARAMETER, "control character in string");
+    }
+
+    if ((UINT8)Parser->Buffer[End] >= 0x80) {
+      Count = JsonStreamCheckUtf8 (Parser->Buffer + End, Parser->Length - End);
+      if (Count == 0) {
+        Parser->Position = End;
+        return JsonStreamError (Parser, EFI_INVALID_PARAMETER, "unable to decode byte");
+      }
+
+      End += Count - 1;
+    }
+
+    if (Parser->Buffer[End] == '\\') {
+      Escaped = TRUE;
+      End++;
+    }
+  }
+
+  if (End >= Parser->Length) {
+    Parser->Position = Parser->Length;
+    return JsonStreamError (Parser, EFI_INVALID_PARAMETER, "premature end of input in string");
+  }
+
+  if (!Escaped) {
+    *String          = Parser->Buffer + Start;
+    *StringLength    = End - Start;
+    Parser->Position = End + 1;
+    return EFI_SUCCESS;
+  }
+
+  if (Parser->ScratchSize < End - Start) {
+    if (Parser->Scratch != NULL) {
+      FreePool (Parser->Scratch);
+    }
+
+    Parser->ScratchSize = End - Start;
+    Parser->Scratch     = AllocatePool (Parser->ScratchSize);
+    if (Parser->Scratch == NULL) {
+      Parser->ScratchSize = 0;
+      return JsonStreamError (Parser, EFI_OUT_OF_RESOURCES, "out of memory");
+    }
+  }
+
+  Source = Parser->Buffer + Start;
+  Target = Parser->Scratch;
+  while (Source < Parser->Buffer + End) {
+    if (*Source != '\\') {
+      *Target++ = *Source++;
+      continue;
+    }
+
+    Parser->Position = (UINTN)(Source - Parser->Buffer);
+    Source++;
+    switch (*Source++) {
+      case '"':
+        *Target++ = '"';
+        break;
+      case '\\':
+        *Target++ = '\\';
+        break;
+      case '/':
+        *Target++ = '/';
+        break;
+      case 'b':
+        *Target++ = '\b';
+        break;
+      case 'f':
+        *Target++ = '\f';
+        break;
+      case 'n':
+        *Target++ = '\n';
+        break;
+      case 'r':
+        *Target++ = '\r';
+        break;
+      case 't':
+        *Target++ = '\t';
+        break;
+      case 'u':
+        if ((Source + 4 > Parser->Buffer + End) || !JsonStreamDecodeHex (Source, &CodePoint)) {
+          return JsonStreamError (Parser, EFI_INVALID_PARAMETER, "invalid \\u escape");
+        }
+
+        Source += 4;
+        if ((CodePoint >= 0xD800) && (CodePoint <= 0xDBFF)) {
+          if ((Source + 6 > Parser->Buffer + End) || (Source[0] != '\\') || (Source[1] != 'u') ||
+              !JsonStreamDecodeHex (Source + 2, &LowSurrogate) ||
+              (LowSurrogate < 0xDC00) || (LowSurrogate > 0xDFFF))
+          {
+            return JsonStreamError (Parser, EFI_INVALID_PARAMETER, "invalid UTF-16 surrogate pair");
+          }
+
+          Source   += 6;
+          CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+        } else if ((CodePoint >= 0xDC00) && (CodePoint <= 0xDFFF)) {
+          return JsonStreamError (Parser, EFI_INVALID_PARAMETER, "invalid UTF-16 surrogate pair");
+        } else if (CodePoint == 0) {
+          return JsonStreamError (Parser, EFI_INVALID_PARAMETER, "\\u0000 is not allowed");
+        }
+
+        //
+        // Encode the code point in UTF-8.
+        //
+        if (CodePoint < 0x80) {
+          *Target++ = (CHAR8)CodePoint;
+        } else if (CodePoint < 0x800) {
+          *Target++ = (CHAR8)(0xC0 | (CodePoint >> 6));
+          *Target++ = (CHAR8)(0x80 | (CodePoint & 0x3F));
+        } else if (CodePoint < 0x10000) {
+          *Target++ = (CHAR8)(0xE0 | (CodePoint >> 12));
+          *Target++ = (CHAR8)(0x80 | ((CodePoint >> 6) & 0x3F));
+          *Target++ = (CHAR8)(0x80 | (CodePoint & 0x3F));
+        } else {
+          *Target++ = (CHAR8)(0xF0 | (CodePoint >> 18));
+          *Target++ = (CHAR8)(0x80 | ((CodePoint >> 12) & 0x3F));
+          *Target++ = (CHAR8)(0x80 | ((CodePoint >> 6) & 0x3F));
+          *Target++ = (CHAR8)(0x80 | (CodePoint & 0x3F));
+        }
+
+        break;
+      default:
+        return JsonStreamError (Parser, EFI_INVALID_PARAMETER, "invalid escape");
+    }
+  }
+
+  *String          = Parser->Scratch;
+  *StringLength    = (UINTN)(Target - Parser->Scratch);
+  Parser->Position = End + 1;
+  return EFI_SUCCESS;
+}
+
+/**
+  Parse an integer token. Real numbers are not supported.
+
+  @param[in]  Parser    Parser instance. Position is at the first character.
+  @param[out] Integer   The parsed integer.
+
+  @retval EFI_SUCCESS             The integer is parsed.
+  @retval EFI_INVALID_PARAMETER   The number is malformed or out of range.
+  @retval EFI_UNSUPPORTED         The number is a real number.
+
+**/
+EFI_STATUS
+JsonStreamParseInteger (
+  IN  JSON_STREAM_PARSER  *Parser,
+  OUT EDKII_JSON_INT_T    *Integer
+  )
+{
+  BOOLEAN  Negative;
+  UINT64   Value;
+  UINT64   Limit;
+  UINT32   Digit;
+  UINTN    Start;
+  CHAR8    Char;
+
+  Negative = FALSE;
+  if (Parser->Buffer[Parser->Position] == '-') {
+    Negative = TRUE;
+    Parser->Position++;
+  }
+
+  Limit = Negative ? (UINT64)MAX_INT64 + 1 : (UINT64)MAX_INT64;
+  Value = 0;
+  Start = Parser->Position;
+  while (Parser->Position < Parser->Length) {
+    Char = Parser->Buffer[Parser->Position];
+    if ((Char < '0') || (Char > '9')) {
+      break;
+    }
+
+    Digit = (UINT32)(Char - '0');
+    if (Value > DivU64x32 (Limit - Digit, 10)) {
+      return JsonStreamError (Parser, EFI_INVALID_PARAMETER, "too big integer");
+    }
+
+    Value = MultU64x32 (Value, 10) + Digit;
+    Parser->Position++;
+  }
+
+  if ((Parser->Position == Start) ||
+      ((Parser->Position - Start > 1) && (Parser->Buffer[Start] == '0')))
+  {
+    return JsonStreamError (Parser, EFI_INVALID_PARAMETER, "invalid number");
+  }
+
+  if (Parser->Position < Parser->Length) {
+    Char = Parser->Buffer[Parser->Position];
+    if ((Char == '.') || (Char == 'e') || (Char == 'E')) {
+      return JsonStreamError (Parser, EFI_UNSUPPORTED, "real number is not supported");
+    }
+  }
+
+  *Integer = Negative ? (EDKII_JSON_INT_T)(0 - Value) : (EDKII_JSON_INT_T)Value;
+  return EFI_SUCCESS;
+}
+
+/**
+  Parse an object key and the name separator that follows it.
+
+  @param[in]  Parser    Parser instance.
+
+  @retval EFI_SUCCESS   The key is parsed and reported.
+  @retval Others        The key is malformed or the callback failed.
+
+**/
+EFI_STATUS
+JsonStreamParseKey (
+  IN JSON_STREAM_PARSER  *Parser
+  )
+{
+  EFI_STATUS   Status;
+  CONST CHAR8  *String;
+  UINTN        StringLength;
+
+  JsonStreamSkipWhiteSpace (Parser);
+  if ((Parser->Position >= Parser->Length) || (Parser->Buffer[Parser->Position] != '"')) {
+    return JsonStreamError (Parser, EFI_INVALID_PARAMETER, "string or '}' expected");
+  }
+
+  Status = JsonStreamParseString (Parser, &String, &StringLength);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = Parser->Callback (EdkiiJsonStreamKey, String, StringLength, 0, Parser->Depth, Parser->Context);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  JsonStreamSkipWhiteSpace (Parser);
+  if ((Parser->Position >= Parser->Length) || (Parser->Buffer[Parser->Position] != ':')) {
+    return JsonStreamError (Parser, EFI_INVALID_PARAMETER, "':' expected");
+  }
+
+  Parser->Position++;
+  return EFI_SUCCESS;
+}
+
+/**
+  Parse a JSON text and report each token to the given callback, without
+  building a JSON value tree. The root value must be an object or an array.
+
+  Keys and strings are passed to the callback as UTF-8 byte sequences that
+  are not NULL terminated and are valid only during the callback. Real
+  numbers are not supported.
+
+  @param[in]      Buffer      Buffer of the JSON payload.
+  @param[in]      BufferLen   Length of the buffer in bytes.
+  @param[in]      Callback    Function called for every token.
+  @param[in]      Context     Context passed to Callback.
+  @param[out]     Error       Optional pointer to receive the position and
+                              description of a parse error.
+
+  @retval EFI_SUCCESS             The whole payload is parsed.
+  @retval EFI_INVALID_PARAMETER   Buffer or Callback is NULL, or the payload
+                                  is malformed.
+  @retval EFI_UNSUPPORTED         The payload contains a real number.
+  @retval EFI_OUT_OF_RESOURCES    System is out of memory.
+  @retval Others                  The error returned by Callback, which stops
+                                  the parsing.
+
+**/
+EFI_STATUS
+EFIAPI
+JsonParseStream (
+  IN     CONST CHAR8                 *Buffer,
+  IN     UINTN                       BufferLen,
+  IN     EDKII_JSON_STREAM_CALLBACK  Callback,
+  IN     VOID                        *Context,
+  OUT    EDKII_JSON_ERROR            *Error  OPTIONAL
+  )
+{
+  EFI_STATUS          Status;
+  JSON_STREAM_PARSER  *Parser;
+  BOOLEAN             ExpectValue;
+  BOOLEAN             InObject;
+  CHAR8               Char;
+  CONST CHAR8         *String;
+  UINTN               StringLength;
+  EDKII_JSON_INT_T    Integer;
+
+  if ((Buffer == NULL) || (Callback == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Parser = AllocateZeroPool (sizeof (JSON_STREAM_PARSER));
+  if (Parser == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Parser->Buffer   = Buffer;
+  Parser->Length   = BufferLen;
+  Parser->Line     = 1;
+  Parser->Callback = Callback;
+  Parser->Context  = Context;
+  Parser->Error    = Error;
+
+  JsonStreamSkipWhiteSpace (Parser);
+  if ((Parser->Position >= Parser->Length) ||
+      ((Parser->Buffer[Parser->Position] != '{') && (Parser->Buffer[Parser->Position] != '[')))
+  {
+    Status = JsonStreamError (Parser, EFI_INVALID_PARAMETER, "'[' or '{' expected");
+    goto Exit;
+  }
+
+  ExpectValue = TRUE;
+  while (TRUE) {
+    JsonStreamSkipWhiteSpace (Parser);
+    if (Parser->Position >= Parser->Length) {
+      Status = JsonStreamError (Parser, EFI_INVALID_PARAMETER, "premature end of input");
+      goto Exit;
+    }
+
+    Char     = Parser->Buffer[Parser->Position];
+    InObject = (BOOLEAN)(Parser->Depth > 0 && (Parser->IsObject[(Parser->Depth - 1) / 8] & (1 << ((Parser->Depth - 1) % 8))) != 0);
+
+    if (!ExpectValue) {
+      //
+      // A value has been parsed. Continue with the enclosing container.
+      //
+      if (Char == ',') {
+        Parser->Position++;
+        if (InObject) {
+          Status = JsonStreamParseKey (Parser);
+          if (EFI_ERROR (Status)) {
+            goto Exit;
+          }
+        }
+
+        ExpectValue = TRUE;
+      } else if (Char == (InObject ? '}' : ']')) {
+        Parser->Position++;
+        Parser->Depth--;
+        Status = Callback (InObject ? EdkiiJsonStreamObjectEnd : EdkiiJsonStreamArrayEnd, NULL, 0, 0, Parser->Depth, Context);
+        if (EFI_ERROR (Status)) {
+          goto Exit;
+        }
+
+        if (Parser->Depth == 0) {
+          break;
+        }
+      } else {
+        Status = JsonStreamError (Parser, EFI_INVALID_PARAMETER, InObject ? "',' or '}' expected" : "',' or ']' expected");
+        goto Exit;
+      }
+
+      continue;
+    }
+
+    switch (Char) {
+      case '{':
+      case '[':
+        if (Parser->Depth >= JSON_STREAM_MAX_DEPTH) {
+          Status = JsonStreamError (Parser, EFI_INVALID_PARAMETER, "maximum parsing depth reached");
+          goto Exit;
+        }
+
+        Parser->Position++;
+        Status = Callback ((Char == '{') ? EdkiiJsonStreamObjectBegin : EdkiiJsonStreamArrayBegin, NULL, 0, 0, Parser->Depth, Context);
+        if (EFI_ERROR (Status)) {
+          goto Exit;
+        }
+
+        if (Char == '{') {
+          Parser->IsObject[Parser->Depth / 8] |= (UINT8)(1 << (Parser->Depth % 8));
+        } else {
+          Parser->IsObject[Parser->Depth / 8] &= (UINT8)~(1 << (Parser->Depth % 8));
+        }
+
+        Parser->Depth++;
+
+        //
+        // Handle the empty container here, since a closing bracket is not
+        // accepted where a value is expected.
+        //
+        JsonStreamSkipWhiteSpace (Parser);
+        if ((Parser->Position < Parser->Length) && (Parser->Buffer[Parser->Position] == ((Char == '{') ? '}' : ']'))) {
+          ExpectValue = FALSE;
+          continue;
+        }
+
+        if (Char == '{') {
+          Status = JsonStreamParseKey (Parser);
+          if (EFI_ERROR (Status)) {
+            goto Exit;
+          }
+        }
+
+        continue;
+
+      case '"':
+        Status = JsonStreamParseString (Parser, &String, &StringLength);
+        if (EFI_ERROR (Status)) {
+          goto Exit;
+        }
+
+        Status = Callback (EdkiiJsonStreamString, String, StringLength, 0, Parser->Depth, Context);
+        break;
+
+      case 't':
+      case 'f':
+      case 'n':
+        String       = (Char == 't') ? "true" : ((Char == 'f') ? "false" : "null");
+        StringLength = AsciiStrLen (String);
+        if ((Parser->Length - Parser->Position < StringLength) ||
+            (CompareMem (Parser->Buffer + Parser->Position, String, StringLength) != 0))
+        {
+          Status = JsonStreamError (Parser, EFI_INVALID_PARAMETER, "invalid token");
+          goto Exit;
+        }
+
+        Parser->Position += StringLength;
+        Status            = Callback (
+                              (Char == 't') ? EdkiiJsonStreamTrue : ((Char == 'f') ? EdkiiJsonStreamFalse : EdkiiJsonStreamNull),
+                              NULL,
+                              0,
+                              0,
+                              Parser->Depth,
+                              Context
+                              );
+        break;
+
+      default:
+        if ((Char != '-') && ((Char < '0') || (Char > '9'))) {
+          Status = JsonStreamError (Parser, EFI_INVALID_PARAMETER, "invalid token");
+          goto Exit;
+        }
+
+        Status = JsonStreamParseInteger (Parser, &Integer);
+        if (EFI_ERROR (Status)) {
+          goto Exit;
+        }
+
+        Status = Callback (EdkiiJsonStreamInteger, NULL, 0, Integer, Parser->Depth, Context);
+        break;
+    }
+
+    if (EFI_ERROR (Status)) {
+      goto Exit;
+    }
+
+    ExpectValue = FALSE;
+  }
+
+  JsonStreamSkipWhiteSpace (Parser);
+  if (Parser->Position < Parser->Length) {
+    Status = JsonStreamError (Parser, EFI_INVALID_PARAMETER, "end of input expected");
+  }
+
+Exit:
+  if (Parser->Scratch != NULL) {
+    FreePool (Parser->Scratch);
+  }
+
+  FreePool (Parser);
+  return Status;
+}
@@ -2306,6 +2306,47 @@ RedfishPlatformConfigFormUpdateNotify (
   return EFI_SUCCESS;
 }
 
+/**
+  Callback function when HII string package is updated. The configure
+  language index of the formset on this HII handle is built from these
+  strings, so it is released and built again on next query.
+
+  @param[in] PackageType  Package type of the notification.
+  @param[in] PackageGuid  If PackageType is
+                          EFI_HII_PACKAGE_TYPE_GUID, then this is
+                          the pointer to the GUID from the Guid
+                          field of EFI_HII_PACKAGE_GUID_HEADER.
+                          Otherwise, it must be NULL.
+  @param[in] Package      Points to the package referred to by the
+                          notification Handle The handle of the package
+                          list which contains the specified package.
+  @param[in] Handle       The HII handle.
+  @param[in] NotifyType   The type of change concerning the
+                          database. See
+                          EFI_HII_DATABASE_NOTIFY_TYPE.
+
+**/
+EFI_STATUS
+EFIAPI
+RedfishPlatformConfigStringUpdateNotify (
+  IN UINT8                         PackageType,
+  IN CONST EFI_GUID                *PackageGuid,
+  IN CONST EFI_HII_PACKAGE_HEADER  *Package,
+  IN EFI_HII_HANDLE                Handle,
+  IN EFI_HII_DATABASE_NOTIFY_TYPE  NotifyType
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = NotifyFormsetStringUpdate (Handle, &mRedfishPlatformConfigPrivate->PendingList);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: failed to notify updated strings of HII handle: 0x%x\n", __func__, Handle));
+    return Status;
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   This is a EFI_HII_STRING_PROTOCOL notification event handler.
 
@@ -2402,6 +2443,22 @@ HiiDatabaseProtocolInstalled (
     DEBUG ((DEBUG_ERROR, "%a: RegisterPackageNotify for EFI_HII_DATABASE_NOTIFY_NEW_PACK failure: %r\n", __func__, Status));
   }
 
+  //
+  // Register package notification when string package is updated. Updating a
+  // package list replaces its string package, which is reported as ADD_PACK.
+  //
+  Status = mRedfishPlatformConfigPrivate->HiiDatabase->RegisterPackageNotify (
+                                                         mRedfishPlatformConfigPrivate->HiiDatabase,
+                                                         EFI_HII_PACKAGE_STRINGS,
+                                                         NULL,
+                                                         RedfishPlatformConfigStringUpdateNotify,
+                                                         EFI_HII_DATABASE_NOTIFY_ADD_PACK,
+                                                         &mRedfishPlatformConfigPrivate->StringNotifyHandle
+                                                         );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "%a: RegisterPackageNotify for EFI_HII_PACKAGE_STRINGS failure: %r\n", __func__, Status));
+  }
+
   gBS->CloseEvent (Event);
   mRedfishPlatformConfigPrivate->HiiDbNotify.ProtocolEvent = NULL;
 }
@@ -2492,6 +2549,13 @@ RedfishPlatformConfigDxeUnload (
                                                     );
     }
 
+    if (mRedfishPlatformConfigPrivate->StringNotifyHandle != NULL) {
+      mRedfishPlatformConfigPrivate->HiiDatabase->UnregisterPackageNotify (
+                                                    mRedfishPlatformConfigPrivate->HiiDatabase,
+                                                    mRedfishPlatformConfigPrivate->StringNotifyHandle
+                                                    );
+    }
+
     ReleaseFormsetList (&mRedfishPlatformConfigPrivate->FormsetList);
     FreePool (mRedfishPlatformConfigPrivate);
     mRedfishPlatformConfigPrivate = NULL;
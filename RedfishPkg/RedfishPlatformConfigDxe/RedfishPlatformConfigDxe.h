@@ -58,6 +58,7 @@ typedef struct {
   REDFISH_PLATFORM_CONFIG_NOTIFY            RegexNotify;
   EFI_REGULAR_EXPRESSION_PROTOCOL           *RegularExpressionProtocol; ///< Regular Expression Protocol.
   EFI_HANDLE                                NotifyHandle;               ///< The notify handle.
+  EFI_HANDLE                                StringNotifyHandle;         ///< The notify handle of string package.
   LIST_ENTRY                                FormsetList;                ///< The list to keep cached HII formset.
   LIST_ENTRY                                PendingList;                ///< The list to keep updated HII handle.
 } REDFISH_PLATFORM_CONFIG_PRIVATE;
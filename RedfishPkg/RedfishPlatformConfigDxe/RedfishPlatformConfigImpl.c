@@ -481,6 +481,308 @@ GetSupportedSchema (
   return EFI_SUCCESS;
 }
 
+/**
+  Compute the hash bucket of the given configure language.
+
+  @param[in]  ConfigureLang   Configure language.
+
+  @retval UINTN               Index of the hash bucket.
+
+**/
+UINTN
+ConfigureLangHash (
+  IN EFI_STRING  ConfigureLang
+  )
+{
+  UINT32  Hash;
+
+  //
+  // FNV-1a over the UCS-2 characters.
+  //
+  Hash = 2166136261;
+  while (*ConfigureLang != L'\0') {
+    Hash = (Hash ^ *ConfigureLang) * 16777619;
+    ConfigureLang++;
+  }
+
+  return Hash % CONFIGURE_LANG_INDEX_BUCKET_COUNT;
+}
+
+/**
+  Release the given configure language index and all its entries.
+
+  @param[in]  ConfigureLangIndex  Configure language index to be released.
+
+**/
+VOID
+ReleaseConfigureLangIndex (
+  IN REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX  *ConfigureLangIndex
+  )
+{
+  LIST_ENTRY                                    *EntryLink;
+  LIST_ENTRY                                    *EntryNextLink;
+  REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY  *Entry;
+
+  EntryLink = GetFirstNode (&ConfigureLangIndex->EntryList);
+  while (!IsNull (&ConfigureLangIndex->EntryList, EntryLink)) {
+    EntryNextLink = GetNextNode (&ConfigureLangIndex->EntryList, EntryLink);
+    Entry         = REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY_FROM_LINK (EntryLink);
+
+    RemoveEntryList (&Entry->Link);
+    RemoveEntryList (&Entry->BucketLink);
+    FreePool (Entry->ConfigureLang);
+    FreePool (Entry);
+    EntryLink = EntryNextLink;
+  }
+
+  if (ConfigureLangIndex->Schema != NULL) {
+    FreePool (ConfigureLangIndex->Schema);
+  }
+
+  RemoveEntryList (&ConfigureLangIndex->Link);
+  FreePool (ConfigureLangIndex);
+}
+
+/**
+  Release every configure language index of the given formset.
+
+  @param[in]  FormsetPrivate  Form-set private instance.
+
+**/
+VOID
+ReleaseConfigureLangIndexList (
+  IN REDFISH_PLATFORM_CONFIG_FORM_SET_PRIVATE  *FormsetPrivate
+  )
+{
+  while (!IsListEmpty (&FormsetPrivate->ConfigureLangIndexList)) {
+    ReleaseConfigureLangIndex (REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX_FROM_LINK (GetFirstNode (&FormsetPrivate->ConfigureLangIndexList)));
+  }
+}
+
+/**
+  Get the configure language index of the given formset and schema. The index
+  is built on first use by reading the configure language of every statement
+  in this formset.
+
+  @param[in]  FormsetPrivate  Form-set private instance.
+  @param[in]  Schema          Schema to be matched.
+
+  @retval REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX *  Pointer to configure language index.
+  @retval NULL                                            System is out of memory.
+
+**/
+REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX *
+GetConfigureLangIndex (
+  IN REDFISH_PLATFORM_CONFIG_FORM_SET_PRIVATE  *FormsetPrivate,
+  IN CHAR8                                     *Schema
+  )
+{
+  LIST_ENTRY                                    *IndexLink;
+  REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX  *ConfigureLangIndex;
+  REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY  *Entry;
+  LIST_ENTRY                                    *HiiFormLink;
+  REDFISH_PLATFORM_CONFIG_FORM_PRIVATE          *HiiFormPrivate;
+  LIST_ENTRY                                    *HiiStatementLink;
+  REDFISH_PLATFORM_CONFIG_STATEMENT_PRIVATE     *HiiStatementPrivate;
+  EFI_STRING                                    TmpString;
+  UINTN                                         Index;
+  UINTN                                         Count;
+
+  IndexLink = GetFirstNode (&FormsetPrivate->ConfigureLangIndexList);
+  while (!IsNull (&FormsetPrivate->ConfigureLangIndexList, IndexLink)) {
+    ConfigureLangIndex = REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX_FROM_LINK (IndexLink);
+    if (AsciiStrCmp (ConfigureLangIndex->Schema, Schema) == 0) {
+      return ConfigureLangIndex;
+    }
+
+    IndexLink = GetNextNode (&FormsetPrivate->ConfigureLangIndexList, IndexLink);
+  }
+
+  ConfigureLangIndex = AllocateZeroPool (sizeof (REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX));
+  if (ConfigureLangIndex == NULL) {
+    DEBUG ((DEBUG_ERROR, "%a: out of resource\n", __func__));
+    return NULL;
+  }
+
+  InitializeListHead (&ConfigureLangIndex->EntryList);
+  for (Index = 0; Index < CONFIGURE_LANG_INDEX_BUCKET_COUNT; Index++) {
+    InitializeListHead (&ConfigureLangIndex->Bucket[Index]);
+  }
+
+  InsertTailList (&FormsetPrivate->ConfigureLangIndexList, &ConfigureLangIndex->Link);
+
+  ConfigureLangIndex->Schema = AllocateCopyPool (AsciiStrSize (Schema), Schema);
+  if (ConfigureLangIndex->Schema == NULL) {
+    goto ErrorExit;
+  }
+
+  Count       = 0;
+  HiiFormLink = GetFirstNode (&FormsetPrivate->HiiFormList);
+  while (!IsNull (&FormsetPrivate->HiiFormList, HiiFormLink)) {
+    HiiFormPrivate = REDFISH_PLATFORM_CONFIG_FORM_FROM_LINK (HiiFormLink);
+
+    HiiStatementLink = GetFirstNode (&HiiFormPrivate->StatementList);
+    while (!IsNull (&HiiFormPrivate->StatementList, HiiStatementLink)) {
+      HiiStatementPrivate = REDFISH_PLATFORM_CONFIG_STATEMENT_FROM_LINK (HiiStatementLink);
+      HiiStatementLink    = GetNextNode (&HiiFormPrivate->StatementList, HiiStatementLink);
+
+      if (HiiStatementPrivate->Description == 0) {
+        continue;
+      }
+
+      TmpString = HiiGetRedfishString (FormsetPrivate->HiiHandle, Schema, HiiStatementPrivate->Description);
+      if (TmpString == NULL) {
+        continue;
+      }
+
+      Entry = AllocateZeroPool (sizeof (REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY));
+      if (Entry == NULL) {
+        FreePool (TmpString);
+        goto ErrorExit;
+      }
+
+      Entry->ConfigureLang = TmpString;
+      Entry->Statement     = HiiStatementPrivate;
+      InsertTailList (&ConfigureLangIndex->EntryList, &Entry->Link);
+      InsertTailList (&ConfigureLangIndex->Bucket[ConfigureLangHash (TmpString)], &Entry->BucketLink);
+      ++Count;
+    }
+
+    HiiFormLink = GetNextNode (&FormsetPrivate->HiiFormList, HiiFormLink);
+  }
+
+  DEBUG ((REDFISH_PLATFORM_CONFIG_DEBUG, "%a: %u configure languages of schema %a indexed in formset: %g\n", __func__, (UINT32)Count, Schema, &FormsetPrivate->Guid));
+
+  return ConfigureLangIndex;
+
+ErrorExit:
+
+  DEBUG ((DEBUG_ERROR, "%a: out of resource\n", __func__));
+  ReleaseConfigureLangIndex (ConfigureLangIndex);
+
+  return NULL;
+}
+
+/**
+  Build the configure language index of the given formset and schema again
+  from the strings in HII database.
+
+  @param[in]  FormsetPrivate  Form-set private instance.
+  @param[in]  Schema          Schema to be matched.
+
+  @retval REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX *  Pointer to configure language index.
+  @retval NULL                                            System is out of memory.
+
+**/
+REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX *
+RebuildConfigureLangIndex (
+  IN REDFISH_PLATFORM_CONFIG_FORM_SET_PRIVATE  *FormsetPrivate,
+  IN CHAR8                                     *Schema
+  )
+{
+  LIST_ENTRY                                    *IndexLink;
+  REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX  *ConfigureLangIndex;
+
+  IndexLink = GetFirstNode (&FormsetPrivate->ConfigureLangIndexList);
+  while (!IsNull (&FormsetPrivate->ConfigureLangIndexList, IndexLink)) {
+    ConfigureLangIndex = REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX_FROM_LINK (IndexLink);
+    if (AsciiStrCmp (ConfigureLangIndex->Schema, Schema) == 0) {
+      ReleaseConfigureLangIndex (ConfigureLangIndex);
+      break;
+    }
+
+    IndexLink = GetNextNode (&FormsetPrivate->ConfigureLangIndexList, IndexLink);
+  }
+
+  return GetConfigureLangIndex (FormsetPrivate, Schema);
+}
+
+/**
+  Check the configure language of an index entry against the string in HII
+  database. HII string protocol changes a string without any notification,
+  so an index entry may be stale.
+
+  @param[in]  FormsetPrivate  Form-set private instance.
+  @param[in]  Schema          Schema of the index.
+  @param[in]  Entry           Index entry to be checked.
+
+  @retval TRUE    The entry holds the current configure language.
+  @retval FALSE   The entry is stale.
+
+**/
+BOOLEAN
+IsConfigureLangEntryCurrent (
+  IN REDFISH_PLATFORM_CONFIG_FORM_SET_PRIVATE      *FormsetPrivate,
+  IN CHAR8                                         *Schema,
+  IN REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY  *Entry
+  )
+{
+  EFI_STRING  TmpString;
+  BOOLEAN     IsCurrent;
+
+  TmpString = HiiGetRedfishString (FormsetPrivate->HiiHandle, Schema, Entry->Statement->Description);
+  if (TmpString == NULL) {
+    return FALSE;
+  }
+
+  IsCurrent = (BOOLEAN)(StrCmp (TmpString, Entry->ConfigureLang) == 0);
+  FreePool (TmpString);
+
+  return IsCurrent;
+}
+
+/**
+  Get the length of the literal prefix that every string matched by the given
+  regular expression pattern must start with. Only patterns anchored with a
+  leading '^' and without alternation have such a prefix.
+
+  @param[in]  Pattern   Regular expression pattern.
+
+  @retval UINTN         Number of literal characters that follow the leading '^'.
+                        0 if there is no literal prefix.
+
+**/
+UINTN
+GetPatternLiteralPrefixLength (
+  IN EFI_STRING  Pattern
+  )
+{
+  UINTN  Length;
+
+  if ((Pattern[0] != L'^') || (StrStr (Pattern, L"|") != NULL)) {
+    return 0;
+  }
+
+  for (Length = 0; Pattern[Length + 1] != L'\0'; Length++) {
+    switch (Pattern[Length + 1]) {
+      case L'*':
+      case L'?':
+      case L'{':
+        //
+        // The quantifier makes the previous character optional.
+        //
+        return (Length > 0) ? Length - 1 : 0;
+
+      case L'.':
+      case L'+':
+      case L'^':
+      case L'$':
+      case L'\\':
+      case L'(':
+      case L')':
+      case L'[':
+      case L']':
+      case L'}':
+        return Length;
+
+      default:
+        break;
+    }
+  }
+
+  return Length;
+}
+
 /**
   Search and find statement private instance by given regular expression pattern
   which describes the Configure Language.
@@ -510,13 +812,10 @@ GetStatementPrivateByConfigureLangRegex (
   LIST_ENTRY                                     *HiiFormsetLink;
   LIST_ENTRY                                     *HiiFormsetNextLink;
   REDFISH_PLATFORM_CONFIG_FORM_SET_PRIVATE       *HiiFormsetPrivate;
-  LIST_ENTRY                                     *HiiFormLink;
-  LIST_ENTRY                                     *HiiNextFormLink;
-  REDFISH_PLATFORM_CONFIG_FORM_PRIVATE           *HiiFormPrivate;
-  LIST_ENTRY                                     *HiiStatementLink;
-  LIST_ENTRY                                     *HiiNextStatementLink;
-  REDFISH_PLATFORM_CONFIG_STATEMENT_PRIVATE      *HiiStatementPrivate;
-  EFI_STRING                                     TmpString;
+  REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX   *ConfigureLangIndex;
+  LIST_ENTRY                                     *EntryLink;
+  REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY   *Entry;
+  UINTN                                          PrefixLength;
   UINTN                                          CaptureCount;
   BOOLEAN                                        IsMatch;
   EFI_STATUS                                     Status;
@@ -537,6 +836,12 @@ GetStatementPrivateByConfigureLangRegex (
     return EFI_NOT_FOUND;
   }
 
+  //
+  // Configure languages that do not start with the literal prefix of an
+  // anchored pattern can not match, so skip them without running the regex.
+  //
+  PrefixLength = GetPatternLiteralPrefixLength (Pattern);
+
   HiiFormsetLink = GetFirstNode (FormsetList);
   while (!IsNull (FormsetList, HiiFormsetLink)) {
     HiiFormsetNextLink = GetNextNode (FormsetList, HiiFormsetLink);
@@ -551,56 +856,57 @@ GetStatementPrivateByConfigureLangRegex (
       continue;
     }
 
-    HiiFormLink = GetFirstNode (&HiiFormsetPrivate->HiiFormList);
-    while (!IsNull (&HiiFormsetPrivate->HiiFormList, HiiFormLink)) {
-      HiiNextFormLink = GetNextNode (&HiiFormsetPrivate->HiiFormList, HiiFormLink);
-      HiiFormPrivate  = REDFISH_PLATFORM_CONFIG_FORM_FROM_LINK (HiiFormLink);
-
-      HiiStatementLink = GetFirstNode (&HiiFormPrivate->StatementList);
-      while (!IsNull (&HiiFormPrivate->StatementList, HiiStatementLink)) {
-        HiiNextStatementLink = GetNextNode (&HiiFormPrivate->StatementList, HiiStatementLink);
-        HiiStatementPrivate  = REDFISH_PLATFORM_CONFIG_STATEMENT_FROM_LINK (HiiStatementLink);
-
-        if ((HiiStatementPrivate->Description != 0) && !HiiStatementPrivate->Suppressed) {
-          TmpString = HiiGetRedfishString (HiiFormsetPrivate->HiiHandle, Schema, HiiStatementPrivate->Description);
-          if (TmpString != NULL) {
-            Status = RegularExpressionProtocol->MatchString (
-                                                  RegularExpressionProtocol,
-                                                  TmpString,
-                                                  Pattern,
-                                                  &gEfiRegexSyntaxTypePerlGuid,
-                                                  &IsMatch,
-                                                  NULL,
-                                                  &CaptureCount
-                                                  );
-            if (EFI_ERROR (Status)) {
-              DEBUG ((DEBUG_ERROR, "%a: MatchString \"%s\" failed: %r\n", __func__, Pattern, Status));
-              ASSERT (FALSE);
-              return Status;
-            }
-
-            //
-            // Found
-            //
-            if (IsMatch) {
-              StatementRef = AllocateZeroPool (sizeof (REDFISH_PLATFORM_CONFIG_STATEMENT_PRIVATE_REF));
-              if (StatementRef == NULL) {
-                return EFI_OUT_OF_RESOURCES;
-              }
-
-              StatementRef->Statement = HiiStatementPrivate;
-              InsertTailList (&StatementList->StatementList, &StatementRef->Link);
-              ++StatementList->Count;
-            }
-
-            FreePool (TmpString);
-          }
-        }
+    //
+    // Each regular expression query reads the configure languages from HII
+    // database again, since they may be changed without any notification.
+    // Only the regular expression matching is saved by the index.
+    //
+    ConfigureLangIndex = RebuildConfigureLangIndex (HiiFormsetPrivate, Schema);
+    if (ConfigureLangIndex == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
 
-        HiiStatementLink = HiiNextStatementLink;
+    EntryLink = GetFirstNode (&ConfigureLangIndex->EntryList);
+    while (!IsNull (&ConfigureLangIndex->EntryList, EntryLink)) {
+      Entry     = REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY_FROM_LINK (EntryLink);
+      EntryLink = GetNextNode (&ConfigureLangIndex->EntryList, EntryLink);
+
+      if (Entry->Statement->Suppressed) {
+        continue;
+      }
+
+      if ((PrefixLength > 0) && (StrnCmp (Entry->ConfigureLang, Pattern + 1, PrefixLength) != 0)) {
+        continue;
       }
 
-      HiiFormLink = HiiNextFormLink;
+      Status = RegularExpressionProtocol->MatchString (
+                                            RegularExpressionProtocol,
+                                            Entry->ConfigureLang,
+                                            Pattern,
+                                            &gEfiRegexSyntaxTypePerlGuid,
+                                            &IsMatch,
+                                            NULL,
+                                            &CaptureCount
+                                            );
+      if (EFI_ERROR (Status)) {
+        DEBUG ((DEBUG_ERROR, "%a: MatchString \"%s\" failed: %r\n", __func__, Pattern, Status));
+        ASSERT (FALSE);
+        return Status;
+      }
+
+      //
+      // Found
+      //
+      if (IsMatch) {
+        StatementRef = AllocateZeroPool (sizeof (REDFISH_PLATFORM_CONFIG_STATEMENT_PRIVATE_REF));
+        if (StatementRef == NULL) {
+          return EFI_OUT_OF_RESOURCES;
+        }
+
+        StatementRef->Statement = Entry->Statement;
+        InsertTailList (&StatementList->StatementList, &StatementRef->Link);
+        ++StatementList->Count;
+      }
     }
 
     HiiFormsetLink = HiiFormsetNextLink;
@@ -626,16 +932,15 @@ GetStatementPrivateByConfigureLang (
   IN  EFI_STRING  ConfigureLang
   )
 {
-  LIST_ENTRY                                 *HiiFormsetLink;
-  LIST_ENTRY                                 *HiiFormsetNextLink;
-  REDFISH_PLATFORM_CONFIG_FORM_SET_PRIVATE   *HiiFormsetPrivate;
-  LIST_ENTRY                                 *HiiFormLink;
-  LIST_ENTRY                                 *HiiNextFormLink;
-  REDFISH_PLATFORM_CONFIG_FORM_PRIVATE       *HiiFormPrivate;
-  LIST_ENTRY                                 *HiiStatementLink;
-  LIST_ENTRY                                 *HiiNextStatementLink;
-  REDFISH_PLATFORM_CONFIG_STATEMENT_PRIVATE  *HiiStatementPrivate;
-  EFI_STRING                                 TmpString;
+  LIST_ENTRY                                    *HiiFormsetLink;
+  LIST_ENTRY                                    *HiiFormsetNextLink;
+  REDFISH_PLATFORM_CONFIG_FORM_SET_PRIVATE      *HiiFormsetPrivate;
+  REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX  *ConfigureLangIndex;
+  LIST_ENTRY                                    *Bucket;
+  LIST_ENTRY                                    *EntryLink;
+  REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY  *Entry;
+  UINTN                                         BucketIndex;
+  UINTN                                         Pass;
 
   if ((FormsetList == NULL) || IS_EMPTY_STRING (Schema) || IS_EMPTY_STRING (ConfigureLang)) {
     return NULL;
@@ -645,55 +950,55 @@ GetStatementPrivateByConfigureLang (
     return NULL;
   }
 
-  HiiFormsetLink = GetFirstNode (FormsetList);
-  while (!IsNull (FormsetList, HiiFormsetLink)) {
-    HiiFormsetNextLink = GetNextNode (FormsetList, HiiFormsetLink);
-    HiiFormsetPrivate  = REDFISH_PLATFORM_CONFIG_FORMSET_FROM_LINK (HiiFormsetLink);
+  BucketIndex = ConfigureLangHash (ConfigureLang);
 
-    //
-    // Performance check.
-    // If there is no desired Redfish schema found, skip this formset.
-    //
-    if (!CheckSupportedSchema (&HiiFormsetPrivate->SupportedSchema, Schema)) {
-      HiiFormsetLink = HiiFormsetNextLink;
-      continue;
-    }
+  //
+  // HII string protocol changes strings without any notification. A hit is
+  // checked against the string in HII database. When the first pass finds
+  // nothing current, the indexes are built again from HII database and
+  // searched once more, so that a changed string is never missed.
+  //
+  for (Pass = 0; Pass < 2; Pass++) {
+    HiiFormsetLink = GetFirstNode (FormsetList);
+    while (!IsNull (FormsetList, HiiFormsetLink)) {
+      HiiFormsetNextLink = GetNextNode (FormsetList, HiiFormsetLink);
+      HiiFormsetPrivate  = REDFISH_PLATFORM_CONFIG_FORMSET_FROM_LINK (HiiFormsetLink);
 
-    HiiFormLink = GetFirstNode (&HiiFormsetPrivate->HiiFormList);
-    while (!IsNull (&HiiFormsetPrivate->HiiFormList, HiiFormLink)) {
-      HiiNextFormLink = GetNextNode (&HiiFormsetPrivate->HiiFormList, HiiFormLink);
-      HiiFormPrivate  = REDFISH_PLATFORM_CONFIG_FORM_FROM_LINK (HiiFormLink);
-
-      HiiStatementLink = GetFirstNode (&HiiFormPrivate->StatementList);
-      while (!IsNull (&HiiFormPrivate->StatementList, HiiStatementLink)) {
-        HiiNextStatementLink = GetNextNode (&HiiFormPrivate->StatementList, HiiStatementLink);
-        HiiStatementPrivate  = REDFISH_PLATFORM_CONFIG_STATEMENT_FROM_LINK (HiiStatementLink);
-
-        DEBUG_CODE (
-          STATIC UINTN Index = 0;
-          Index++;
-          DEBUG ((REDFISH_PLATFORM_CONFIG_DEBUG, "%a: [%d] search %s in QID: 0x%x form: 0x%x formset: %g\n", __func__, Index, ConfigureLang, HiiStatementPrivate->QuestionId, HiiFormPrivate->Id, &HiiFormsetPrivate->Guid));
-          );
-
-        if (HiiStatementPrivate->Description != 0) {
-          TmpString = HiiGetRedfishString (HiiFormsetPrivate->HiiHandle, Schema, HiiStatementPrivate->Description);
-          if (TmpString != NULL) {
-            if (StrCmp (TmpString, ConfigureLang) == 0) {
-              FreePool (TmpString);
-              return HiiStatementPrivate;
-            }
-
-            FreePool (TmpString);
-          }
+      //
+      // Performance check.
+      // If there is no desired Redfish schema found, skip this formset.
+      //
+      if (!CheckSupportedSchema (&HiiFormsetPrivate->SupportedSchema, Schema)) {
+        HiiFormsetLink = HiiFormsetNextLink;
+        continue;
+      }
+
+      if (Pass == 0) {
+        ConfigureLangIndex = GetConfigureLangIndex (HiiFormsetPrivate, Schema);
+      } else {
+        ConfigureLangIndex = RebuildConfigureLangIndex (HiiFormsetPrivate, Schema);
+      }
+
+      if (ConfigureLangIndex == NULL) {
+        return NULL;
+      }
+
+      Bucket    = &ConfigureLangIndex->Bucket[BucketIndex];
+      EntryLink = GetFirstNode (Bucket);
+      while (!IsNull (Bucket, EntryLink)) {
+        Entry = REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY_FROM_BUCKET_LINK (EntryLink);
+        if ((StrCmp (Entry->ConfigureLang, ConfigureLang) == 0) &&
+            IsConfigureLangEntryCurrent (HiiFormsetPrivate, Schema, Entry))
+        {
+          DEBUG ((REDFISH_PLATFORM_CONFIG_DEBUG, "%a: %s found in QID: 0x%x form: 0x%x formset: %g\n", __func__, ConfigureLang, Entry->Statement->QuestionId, Entry->Statement->ParentForm->Id, &HiiFormsetPrivate->Guid));
+          return Entry->Statement;
         }
 
-        HiiStatementLink = HiiNextStatementLink;
+        EntryLink = GetNextNode (Bucket, EntryLink);
       }
 
-      HiiFormLink = HiiNextFormLink;
+      HiiFormsetLink = HiiFormsetNextLink;
     }
-
-    HiiFormsetLink = HiiFormsetNextLink;
   }
 
   return NULL;
@@ -766,6 +1071,11 @@ ReleaseFormset (
     return EFI_INVALID_PARAMETER;
   }
 
+  //
+  // Release configure language index before the statements it refers to.
+  //
+  ReleaseConfigureLangIndexList (FormsetPrivate);
+
   HiiFormLink = GetFirstNode (&FormsetPrivate->HiiFormList);
   while (!IsNull (&FormsetPrivate->HiiFormList, HiiFormLink)) {
     HiiFormPrivate  = REDFISH_PLATFORM_CONFIG_FORM_FROM_LINK (HiiFormLink);
@@ -846,6 +1156,7 @@ NewFormsetPrivate (
   // Initial newly created formset private data.
   //
   InitializeListHead (&NewFormsetPrivate->HiiFormList);
+  InitializeListHead (&NewFormsetPrivate->ConfigureLangIndexList);
 
   return NewFormsetPrivate;
 }
@@ -1181,7 +1492,8 @@ NotifyFormsetUpdate (
   //
   TargetPendingList = GetPendingList (HiiHandle, PendingList);
   if (TargetPendingList != NULL) {
-    TargetPendingList->IsDeleted = FALSE;
+    TargetPendingList->IsDeleted       = FALSE;
+    TargetPendingList->IsStringUpdated = FALSE;
     DEBUG_CODE (
       DEBUG ((REDFISH_PLATFORM_CONFIG_DEBUG, "%a: HII handle: 0x%x is updated\n", __func__, HiiHandle));
       );
@@ -1234,7 +1546,8 @@ NotifyFormsetDeleted (
   //
   TargetPendingList = GetPendingList (HiiHandle, PendingList);
   if (TargetPendingList != NULL) {
-    TargetPendingList->IsDeleted = TRUE;
+    TargetPendingList->IsDeleted       = TRUE;
+    TargetPendingList->IsStringUpdated = FALSE;
     DEBUG_CODE (
       DEBUG ((REDFISH_PLATFORM_CONFIG_DEBUG, "%a: HII handle: 0x%x is updated and deleted\n", __func__, HiiHandle));
       );
@@ -1258,6 +1571,58 @@ NotifyFormsetDeleted (
   return EFI_SUCCESS;
 }
 
+/**
+  When HII database is updated and only the strings of form-set are changed. Keep
+  this HII handle into pending list so the configure language index can be released
+  later.
+
+  @param[in]  HiiHandle   HII handle instance.
+  @param[in]  PendingList Pending list to keep HII handle which is recently updated.
+
+  @retval EFI_SUCCESS             HII handle is saved in pending list.
+  @retval EFI_INVALID_PARAMETER   HiiHandle is NULL or PendingList is NULL.
+  @retval EFI_OUT_OF_RESOURCES    System is out of memory.
+
+**/
+EFI_STATUS
+NotifyFormsetStringUpdate (
+  IN  EFI_HII_HANDLE  *HiiHandle,
+  IN  LIST_ENTRY      *PendingList
+  )
+{
+  REDFISH_PLATFORM_CONFIG_PENDING_LIST  *TargetPendingList;
+
+  if ((HiiHandle == NULL) || (PendingList == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  //
+  // Reloading or deleting the formset releases the index too, so there is
+  // nothing to do if this HII handle is in pending list already.
+  //
+  TargetPendingList = GetPendingList (HiiHandle, PendingList);
+  if (TargetPendingList != NULL) {
+    return EFI_SUCCESS;
+  }
+
+  TargetPendingList = AllocateZeroPool (sizeof (REDFISH_PLATFORM_CONFIG_PENDING_LIST));
+  if (TargetPendingList == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  TargetPendingList->HiiHandle       = HiiHandle;
+  TargetPendingList->IsDeleted       = FALSE;
+  TargetPendingList->IsStringUpdated = TRUE;
+
+  InsertTailList (PendingList, &TargetPendingList->Link);
+
+  DEBUG_CODE (
+    DEBUG ((REDFISH_PLATFORM_CONFIG_DEBUG, "%a: HII handle: 0x%x strings are updated\n", __func__, HiiHandle));
+    );
+
+  return EFI_SUCCESS;
+}
+
 /**
   There are HII database update and we need to process them accordingly so that we
   won't use stale data. This function will parse updated HII handle again in order
@@ -1308,6 +1673,17 @@ ProcessPendingList (
       } else {
         DEBUG ((REDFISH_PLATFORM_CONFIG_DEBUG, "%a: formset on HII handle 0x%x was removed already\n", __func__, Target->HiiHandle));
       }
+    } else if (Target->IsStringUpdated) {
+      //
+      // Only the strings on this HII handle are updated. The configure language
+      // index is built from these strings, so release it and build it again on
+      // next query.
+      //
+      FormsetPrivate = GetFormsetPrivateByHiiHandle (Target->HiiHandle, FormsetList);
+      if (FormsetPrivate != NULL) {
+        DEBUG ((REDFISH_PLATFORM_CONFIG_DEBUG, "%a: strings of formset: %g are updated. Release configure language index\n", __func__, &FormsetPrivate->Guid));
+        ReleaseConfigureLangIndexList (FormsetPrivate);
+      }
     } else {
       //
       // The HII resource on this HII handle is updated/removed.
@@ -30,6 +30,8 @@
 #define ENGLISH_LANGUAGE_CODE  "en-US"
 #define X_UEFI_SCHEMA_PREFIX   "x-uefi-redfish-"
 
+#define CONFIGURE_LANG_INDEX_BUCKET_COUNT  256
+
 //
 // Definition of REDFISH_PLATFORM_CONFIG_PRIVATE.
 //
@@ -37,6 +39,7 @@ typedef struct {
   LIST_ENTRY        Link;
   EFI_HII_HANDLE    HiiHandle;
   BOOLEAN           IsDeleted;
+  BOOLEAN           IsStringUpdated;
 } REDFISH_PLATFORM_CONFIG_PENDING_LIST;
 
 #define REDFISH_PLATFORM_CONFIG_PENDING_LIST_FROM_LINK(a)  BASE_CR (a, REDFISH_PLATFORM_CONFIG_PENDING_LIST, Link)
@@ -51,12 +54,13 @@ typedef struct {
 //
 typedef struct {
   LIST_ENTRY                        Link;
-  HII_FORMSET                       *HiiFormSet;     // Pointer to HII formset data.
-  EFI_GUID                          Guid;            // Formset GUID.
-  EFI_HII_HANDLE                    HiiHandle;       // Hii Handle of this formset.
-  LIST_ENTRY                        HiiFormList;     // Form list that keep form data under this formset.
-  CHAR16                            *DevicePathStr;  // Device path of this formset.
-  REDFISH_PLATFORM_CONFIG_SCHEMA    SupportedSchema; // Schema that is supported in this formset.
+  HII_FORMSET                       *HiiFormSet;            // Pointer to HII formset data.
+  EFI_GUID                          Guid;                   // Formset GUID.
+  EFI_HII_HANDLE                    HiiHandle;              // Hii Handle of this formset.
+  LIST_ENTRY                        HiiFormList;            // Form list that keep form data under this formset.
+  CHAR16                            *DevicePathStr;         // Device path of this formset.
+  REDFISH_PLATFORM_CONFIG_SCHEMA    SupportedSchema;        // Schema that is supported in this formset.
+  LIST_ENTRY                        ConfigureLangIndexList; // Configure language index of each schema.
 } REDFISH_PLATFORM_CONFIG_FORM_SET_PRIVATE;
 
 #define REDFISH_PLATFORM_CONFIG_FORMSET_FROM_LINK(a)  BASE_CR (a, REDFISH_PLATFORM_CONFIG_FORM_SET_PRIVATE, Link)
@@ -116,6 +120,34 @@ typedef struct {
 
 #define REDFISH_PLATFORM_CONFIG_STATEMENT_REF_FROM_LINK(a)  BASE_CR (a, REDFISH_PLATFORM_CONFIG_STATEMENT_PRIVATE_REF, Link)
 
+//
+// Definition of REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY
+//
+typedef struct {
+  LIST_ENTRY                                   Link;          // Link in index entry list, in statement order.
+  LIST_ENTRY                                   BucketLink;    // Link in hash bucket.
+  EFI_STRING                                   ConfigureLang; // Configure language of this statement.
+  REDFISH_PLATFORM_CONFIG_STATEMENT_PRIVATE    *Statement;
+} REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY;
+
+#define REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY_FROM_LINK(a)         BASE_CR (a, REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY, Link)
+#define REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY_FROM_BUCKET_LINK(a)  BASE_CR (a, REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY, BucketLink)
+
+//
+// Definition of REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX
+//
+// Configure languages of all statements in one formset for one schema. It is
+// built on first search and released together with the formset.
+//
+typedef struct {
+  LIST_ENTRY    Link;
+  CHAR8         *Schema;                                    // Schema of this index.
+  LIST_ENTRY    EntryList;                                  // List of REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_ENTRY
+  LIST_ENTRY    Bucket[CONFIGURE_LANG_INDEX_BUCKET_COUNT];  // Hash buckets of configure language.
+} REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX;
+
+#define REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX_FROM_LINK(a)  BASE_CR (a, REDFISH_PLATFORM_CONFIG_CONFIGURE_LANG_INDEX, Link)
+
 //
 // Definition of REDFISH_PLATFORM_CONFIG_STATEMENT_PRIVATE_LIST
 //
@@ -189,6 +221,25 @@ NotifyFormsetDeleted (
   IN  LIST_ENTRY      *PendingList
   );
 
+/**
+  When HII database is updated and only the strings of form-set are changed. Keep
+  this HII handle into pending list so the configure language index can be released
+  later.
+
+  @param[in]  HiiHandle   HII handle instance.
+  @param[in]  PendingList Pending list to keep HII handle which is recently updated.
+
+  @retval EFI_SUCCESS             HII handle is saved in pending list.
+  @retval EFI_INVALID_PARAMETER   HiiHandle is NULL or PendingList is NULL.
+  @retval EFI_OUT_OF_RESOURCES    System is out of memory.
+
+**/
+EFI_STATUS
+NotifyFormsetStringUpdate (
+  IN  EFI_HII_HANDLE  *HiiHandle,
+  IN  LIST_ENTRY      *PendingList
+  );
+
 /**
   Get statement private instance by the given configure language.
 
@@ -0,0 +1,385 @@
+/** @file
+  Unit tests of JsonParseStream() in JsonLib.
+
+  Every payload is parsed with both JsonParseStream() and JsonLoadBuffer().
+  For a valid payload, the tokens reported by JsonParseStream() must match a
+  walk of the value loaded by JsonLoadBuffer(). For an invalid payload, both
+  must fail.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/JsonLib.h>
+#include <Library/PrintLib.h>
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_APP_NAME     "JsonLib Unit Test Application"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define JSON_TEST_TRACE_SIZE  0x400
+
+typedef struct {
+  CONST CHAR8    *Payload;
+  BOOLEAN        Valid;
+} JSON_STREAM_TEST_CONTEXT;
+
+//
+// Text form of a token sequence. Each token is a tag character, followed by
+// the length and bytes of a key or string, or by the value of an integer.
+//
+typedef struct {
+  CHAR8      Text[JSON_TEST_TRACE_SIZE];
+  UINTN      Length;
+  BOOLEAN    Overflow;
+} JSON_TEST_TRACE;
+
+STATIC JSON_TEST_TRACE  mStreamTrace;
+STATIC JSON_TEST_TRACE  mLoadTrace;
+
+//
+// Valid payloads
+//
+STATIC JSON_STREAM_TEST_CONTEXT  mEmptyObject   = { "{}", TRUE };
+STATIC JSON_STREAM_TEST_CONTEXT  mEmptyArray    = { " [ ]\r\n", TRUE };
+STATIC JSON_STREAM_TEST_CONTEXT  mNested        = { "{\"a\":1,\"b\":[true,false,null],\"c\":{\"d\":\"e\",\"f\":[[],{}]}}", TRUE };
+STATIC JSON_STREAM_TEST_CONTEXT  mIntegers      = { "[0,-0,1,-2,9223372036854775807,-9223372036854775808]", TRUE };
+STATIC JSON_STREAM_TEST_CONTEXT  mEscapes       = { "[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\",\"plain\"]", TRUE };
+STATIC JSON_STREAM_TEST_CONTEXT  mUnicodeEscape = { "[\"\\u00e9\\u20AC\\ud83d\\ude00\"]", TRUE };
+STATIC JSON_STREAM_TEST_CONTEXT  mUtf8          = { "{\"k\xC3\xA9y\":\"\xE2\x82\xAC\xF0\x9F\x98\x80\"}", TRUE };
+
+//
+// Invalid payloads
+//
+STATIC JSON_STREAM_TEST_CONTEXT  mEmpty             = { "", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mRootScalar        = { "1", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mRootString        = { "\"a\"", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mTrailingComma     = { "[1,]", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mMissingValue      = { "{\"a\"}", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mMissingComma      = { "[1 2]", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mTrailingGarbage   = { "[1] x", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mUnterminated      = { "[\"abc]", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mLeadingZero       = { "[01]", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mIntegerOverflow   = { "[9223372036854775808]", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mControlCharacter  = { "[\"\t\"]", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mInvalidEscape     = { "[\"\\x\"]", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mNulEscape         = { "[\"\\u0000\"]", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mLoneSurrogate     = { "[\"\\ud800\"]", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mUtf8Continuation  = { "[\"\x80\"]", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mUtf8Overlong      = { "[\"\xC0\xAF\"]", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mUtf8Surrogate     = { "[\"\xED\xA0\x80\"]", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mUtf8OutOfRange    = { "[\"\xF4\x90\x80\x80\"]", FALSE };
+STATIC JSON_STREAM_TEST_CONTEXT  mUtf8Truncated     = { "[\"\xE2\x82\"]", FALSE };
+
+/**
+  Append a token to a trace.
+
+  @param[in, out] Trace     The trace.
+  @param[in]      Tag       The tag character of the token.
+  @param[in]      String    The key or string of the token, or NULL.
+  @param[in]      Length    Length of String in bytes.
+  @param[in]      Integer   The value of an integer token.
+
+**/
+STATIC
+VOID
+JsonTestTraceAppend (
+  IN OUT JSON_TEST_TRACE   *Trace,
+  IN     CHAR8             Tag,
+  IN     CONST CHAR8       *String,
+  IN     UINTN             Length,
+  IN     EDKII_JSON_INT_T  Integer
+  )
+{
+  UINTN  Size;
+
+  Size = JSON_TEST_TRACE_SIZE - Trace->Length;
+  if (String != NULL) {
+    Trace->Length += AsciiSPrint (Trace->Text + Trace->Length, Size, "%c%Lu:", Tag, (UINT64)Length);
+    Size           = JSON_TEST_TRACE_SIZE - Trace->Length;
+    if (Length >= Size) {
+      Trace->Overflow = TRUE;
+      return;
+    }
+
+    CopyMem (Trace->Text + Trace->Length, String, Length);
+    Trace->Length += Length;
+  } else if (Tag == 'I') {
+    Trace->Length += AsciiSPrint (Trace->Text + Trace->Length, Size, "%c%Ld", Tag, Integer);
+  } else {
+    Trace->Length += AsciiSPrint (Trace->Text + Trace->Length, Size, "%c", Tag);
+  }
+
+  if (Trace->Length + 1 >= JSON_TEST_TRACE_SIZE) {
+    Trace->Overflow = TRUE;
+  }
+}
+
+/**
+  Callback of JsonParseStream() recording each token in a trace.
+
+  @param[in]   Event          The token type.
+  @param[in]   String         UTF-8 bytes of the key or string, or NULL.
+  @param[in]   StringLength   Length of String in bytes.
+  @param[in]   Integer        Value of an integer token.
+  @param[in]   Depth          Number of containers enclosing this token.
+  @param[in]   Context        The trace.
+
+  @retval      EFI_SUCCESS    Continue parsing.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+JsonStreamTestCallback (
+  IN  EDKII_JSON_STREAM_EVENT  Event,
+  IN  CONST CHAR8              *String,
+  IN  UINTN                    StringLength,
+  IN  EDKII_JSON_INT_T         Integer,
+  IN  UINTN                    Depth,
+  IN  VOID                     *Context
+  )
+{
+  STATIC CONST CHAR8  Tags[] = "{}[]KSITFN";
+
+  JsonTestTraceAppend ((JSON_TEST_TRACE *)Context, Tags[Event], String, StringLength, Integer);
+  return EFI_SUCCESS;
+}
+
+/**
+  Record a value loaded by JsonLoadBuffer() and all its children in a trace,
+  in the order JsonParseStream() reports them.
+
+  @param[in, out] Trace     The trace.
+  @param[in]      Value     The JSON value.
+
+**/
+STATIC
+VOID
+JsonLoadTraceValue (
+  IN OUT JSON_TEST_TRACE   *Trace,
+  IN     EDKII_JSON_VALUE  Value
+  )
+{
+  VOID         *Iterator;
+  CONST CHAR8  *String;
+  UINTN        Index;
+  UINTN        Count;
+
+  switch (JsonGetType (Value)) {
+    case EdkiiJsonTypeObject:
+      JsonTestTraceAppend (Trace, '{', NULL, 0, 0);
+      for (Iterator = JsonObjectIterator (Value); Iterator != NULL; Iterator = JsonObjectIteratorNext (Value, Iterator)) {
+        String = JsonObjectIteratorKey (Iterator);
+        JsonTestTraceAppend (Trace, 'K', String, AsciiStrLen (String), 0);
+        JsonLoadTraceValue (Trace, JsonObjectIteratorValue (Iterator));
+      }
+
+      JsonTestTraceAppend (Trace, '}', NULL, 0, 0);
+      break;
+    case EdkiiJsonTypeArray:
+      JsonTestTraceAppend (Trace, '[', NULL, 0, 0);
+      Count = JsonArrayCount (JsonValueGetArray (Value));
+      for (Index = 0; Index < Count; Index++) {
+        JsonLoadTraceValue (Trace, JsonArrayGetValue (JsonValueGetArray (Value), Index));
+      }
+
+      JsonTestTraceAppend (Trace, ']', NULL, 0, 0);
+      break;
+    case EdkiiJsonTypeString:
+      String = JsonValueGetString (Value);
+      JsonTestTraceAppend (Trace, 'S', String, AsciiStrLen (String), 0);
+      break;
+    case EdkiiJsonTypeInteger:
+      JsonTestTraceAppend (Trace, 'I', NULL, 0, JsonValueGetInteger (Value));
+      break;
+    case EdkiiJsonTypeTrue:
+      JsonTestTraceAppend (Trace, 'T', NULL, 0, 0);
+      break;
+    case EdkiiJsonTypeFalse:
+      JsonTestTraceAppend (Trace, 'F', NULL, 0, 0);
+      break;
+    case EdkiiJsonTypeNull:
+      JsonTestTraceAppend (Trace, 'N', NULL, 0, 0);
+      break;
+    default:
+      JsonTestTraceAppend (Trace, 'R', NULL, 0, 0);
+      break;
+  }
+}
+
+/**
+  Unit test comparing JsonParseStream() with JsonLoadBuffer().
+
+  @param[in]  Context    The JSON_STREAM_TEST_CONTEXT of the payload.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+JsonParseStreamTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  JSON_STREAM_TEST_CONTEXT  *TestContext;
+  EDKII_JSON_VALUE          Value;
+  EDKII_JSON_ERROR          Error;
+  EFI_STATUS                Status;
+  UINTN                     Length;
+
+  TestContext = (JSON_STREAM_TEST_CONTEXT *)Context;
+  Length      = AsciiStrLen (TestContext->Payload);
+  ZeroMem (&mStreamTrace, sizeof (mStreamTrace));
+  ZeroMem (&mLoadTrace, sizeof (mLoadTrace));
+
+  Status = JsonParseStream (TestContext->Payload, Length, JsonStreamTestCallback, &mStreamTrace, &Error);
+  Value  = JsonLoadBuffer (TestContext->Payload, Length, 0, &Error);
+  if (Value != NULL) {
+    JsonLoadTraceValue (&mLoadTrace, Value);
+    JsonValueFree (Value);
+  }
+
+  if (!TestContext->Valid) {
+    UT_ASSERT_TRUE (EFI_ERROR (Status));
+    UT_ASSERT_TRUE (Value == NULL);
+    return UNIT_TEST_PASSED;
+  }
+
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_NOT_NULL (Value);
+  UT_ASSERT_FALSE (mStreamTrace.Overflow);
+  UT_ASSERT_FALSE (mLoadTrace.Overflow);
+  UT_ASSERT_EQUAL (mStreamTrace.Length, mLoadTrace.Length);
+  UT_ASSERT_MEM_EQUAL (mStreamTrace.Text, mLoadTrace.Text, mLoadTrace.Length);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Unit test checking that JsonParseStream() rejects real numbers.
+
+  @param[in]  Context    Unused.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+JsonParseStreamRealTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  EFI_STATUS  Status;
+
+  ZeroMem (&mStreamTrace, sizeof (mStreamTrace));
+  Status = JsonParseStream ("[1.5]", 5, JsonStreamTestCallback, &mStreamTrace, NULL);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_UNSUPPORTED);
+
+  Status = JsonParseStream ("[1e5]", 5, JsonStreamTestCallback, &mStreamTrace, NULL);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_UNSUPPORTED);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for
+  JsonParseStream() in JsonLib and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Fw;
+  UNIT_TEST_SUITE_HANDLE      StreamTests;
+
+  Fw = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Fw, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  //
+  // Populate the Unit Test Suite.
+  //
+  Status = CreateUnitTestSuite (&StreamTests, Fw, "JsonParseStream Test", "JsonLib.JsonParseStream", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for StreamTests\n"));
+    goto EXIT;
+  }
+
+  AddTestCase (StreamTests, "Empty object", "Valid1", JsonParseStreamTest, NULL, NULL, &mEmptyObject);
+  AddTestCase (StreamTests, "Empty array", "Valid2", JsonParseStreamTest, NULL, NULL, &mEmptyArray);
+  AddTestCase (StreamTests, "Nested containers", "Valid3", JsonParseStreamTest, NULL, NULL, &mNested);
+  AddTestCase (StreamTests, "Integer limits", "Valid4", JsonParseStreamTest, NULL, NULL, &mIntegers);
+  AddTestCase (StreamTests, "Escape sequences", "Valid5", JsonParseStreamTest, NULL, NULL, &mEscapes);
+  AddTestCase (StreamTests, "Unicode escapes", "Valid6", JsonParseStreamTest, NULL, NULL, &mUnicodeEscape);
+  AddTestCase (StreamTests, "UTF-8 keys and strings", "Valid7", JsonParseStreamTest, NULL, NULL, &mUtf8);
+  AddTestCase (StreamTests, "Error: Empty payload", "Invalid1", JsonParseStreamTest, NULL, NULL, &mEmpty);
+  AddTestCase (StreamTests, "Error: Scalar root", "Invalid2", JsonParseStreamTest, NULL, NULL, &mRootScalar);
+  AddTestCase (StreamTests, "Error: String root", "Invalid3", JsonParseStreamTest, NULL, NULL, &mRootString);
+  AddTestCase (StreamTests, "Error: Trailing comma", "Invalid4", JsonParseStreamTest, NULL, NULL, &mTrailingComma);
+  AddTestCase (StreamTests, "Error: Missing value", "Invalid5", JsonParseStreamTest, NULL, NULL, &mMissingValue);
+  AddTestCase (StreamTests, "Error: Missing comma", "Invalid6", JsonParseStreamTest, NULL, NULL, &mMissingComma);
+  AddTestCase (StreamTests, "Error: Trailing garbage", "Invalid7", JsonParseStreamTest, NULL, NULL, &mTrailingGarbage);
+  AddTestCase (StreamTests, "Error: Unterminated string", "Invalid8", JsonParseStreamTest, NULL, NULL, &mUnterminated);
+  AddTestCase (StreamTests, "Error: Leading zero", "Invalid9", JsonParseStreamTest, NULL, NULL, &mLeadingZero);
+  AddTestCase (StreamTests, "Error: Integer overflow", "Invalid10", JsonParseStreamTest, NULL, NULL, &mIntegerOverflow);
+  AddTestCase (StreamTests, "Error: Control character", "Invalid11", JsonParseStreamTest, NULL, NULL, &mControlCharacter);
+  AddTestCase (StreamTests, "Error: Invalid escape", "Invalid12", JsonParseStreamTest, NULL, NULL, &mInvalidEscape);
+  AddTestCase (StreamTests, "Error: NUL escape", "Invalid13", JsonParseStreamTest, NULL, NULL, &mNulEscape);
+  AddTestCase (StreamTests, "Error: Lone surrogate escape", "Invalid14", JsonParseStreamTest, NULL, NULL, &mLoneSurrogate);
+  AddTestCase (StreamTests, "Error: UTF-8 continuation byte", "Invalid15", JsonParseStreamTest, NULL, NULL, &mUtf8Continuation);
+  AddTestCase (StreamTests, "Error: UTF-8 overlong encoding", "Invalid16", JsonParseStreamTest, NULL, NULL, &mUtf8Overlong);
+  AddTestCase (StreamTests, "Error: UTF-8 surrogate", "Invalid17", JsonParseStreamTest, NULL, NULL, &mUtf8Surrogate);
+  AddTestCase (StreamTests, "Error: UTF-8 above U+10FFFF", "Invalid18", JsonParseStreamTest, NULL, NULL, &mUtf8OutOfRange);
+  AddTestCase (StreamTests, "Error: UTF-8 truncated", "Invalid19", JsonParseStreamTest, NULL, NULL, &mUtf8Truncated);
+  AddTestCase (StreamTests, "Real numbers are unsupported", "Real", JsonParseStreamRealTest, NULL, NULL, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Fw);
+
+EXIT:
+  if (Fw) {
+    FreeUnitTestFramework (Fw);
+  }
+
+  return Status;
+}
+
+/**
+  Standard UEFI entry point for target based unit test execution from UEFI Shell.
+**/
+EFI_STATUS
+EFIAPI
+JsonLibUnitTestAppEntry (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  return UnitTestingEntry ();
+}
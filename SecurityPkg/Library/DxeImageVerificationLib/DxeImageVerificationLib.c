@@ -19,6 +19,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 **/
 
 #include "DxeImageVerificationLib.h"
+#include <Library/PerformanceLib.h>
 
 //
 // Caution: This is used by a function which may receive untrusted input.
@@ -36,6 +37,14 @@ UINT8  *mImageBase = NULL;
 UINT8  mImageDigest[MAX_DIGEST_SIZE];
 UINTN  mImageDigestSize;
 
+//
+// Authenticode digests of the current PE/COFF image, one per hash algorithm.
+// They are computed on first use and dropped when the verification completes,
+// so an image with several signatures is hashed at most once per algorithm.
+//
+UINT8    mImageDigestCache[HASHALG_MAX][MAX_DIGEST_SIZE];
+BOOLEAN  mImageDigestCached[HASHALG_MAX];
+
 //
 // Notify string for authorization UI.
 //
@@ -71,6 +80,15 @@ HASH_TABLE  mHash[] = {
 
 EFI_STRING  mHashTypeStr;
 
+//
+// Signature databases read during the verification of the current image.
+//
+SIGNATURE_DATABASE_SNAPSHOT  mSignatureDatabase[] = {
+  { EFI_IMAGE_SECURITY_DATABASE,  FALSE, EFI_NOT_FOUND, NULL, 0 },
+  { EFI_IMAGE_SECURITY_DATABASE1, FALSE, EFI_NOT_FOUND, NULL, 0 },
+  { EFI_IMAGE_SECURITY_DATABASE2, FALSE, EFI_NOT_FOUND, NULL, 0 }
+};
+
 /**
   SecureBoot Hook for processing image verification.
 
@@ -275,6 +293,9 @@ GetImageType (
   Calculate hash of Pe/Coff image based on the authenticode image hashing in
   PE/COFF Specification 8.0 Appendix A
 
+  If the image has already been hashed with HashAlg during the current
+  verification, the cached digest is returned instead.
+
   Caution: This function may receive untrusted input.
   PE/COFF image is external input, so this function will validate its data structure
   within this image buffer before use.
@@ -347,7 +368,13 @@ HashPeImage (
   }
 
   mHashTypeStr = mHash[HashAlg].Name;
-  CtxSize      = mHash[HashAlg].GetContextSize ();
+
+  if (mImageDigestCached[HashAlg]) {
+    CopyMem (mImageDigest, mImageDigestCache[HashAlg], mImageDigestSize);
+    return TRUE;
+  }
+
+  CtxSize = mHash[HashAlg].GetContextSize ();
 
   HashCtx = AllocatePool (CtxSize);
   if (HashCtx == NULL) {
@@ -592,6 +619,10 @@ HashPeImage (
   }
 
   Status = mHash[HashAlg].HashFinal (HashCtx, mImageDigest);
+  if (Status) {
+    CopyMem (mImageDigestCache[HashAlg], mImageDigest, mImageDigestSize);
+    mImageDigestCached[HashAlg] = TRUE;
+  }
 
 Done:
   if (HashCtx != NULL) {
@@ -826,6 +857,102 @@ AddImageExeInfo (
   }
 }
 
+/**
+  Get the content of a signature database variable.
+
+  The variable is read on the first request during the verification of an
+  image, and the same content is returned until FreeSignatureDatabases() is
+  called at the end of the verification.
+
+  @param[in]  VariableName    Name of the database variable: db, dbx or dbt.
+  @param[out] Data            Content of the variable. It must not be freed
+                              by the caller.
+  @param[out] DataSize        Size of the content in bytes.
+
+  @retval EFI_SUCCESS           The content of the variable is returned.
+  @retval EFI_NOT_FOUND         The variable does not exist.
+  @retval EFI_OUT_OF_RESOURCES  There is not enough memory to hold the content.
+  @retval Others                The variable could not be read.
+
+**/
+EFI_STATUS
+GetSignatureDatabase (
+  IN  CHAR16  *VariableName,
+  OUT UINT8   **Data,
+  OUT UINTN   *DataSize
+  )
+{
+  SIGNATURE_DATABASE_SNAPSHOT  *Snapshot;
+  UINTN                        Index;
+
+  *Data     = NULL;
+  *DataSize = 0;
+  Snapshot  = NULL;
+  for (Index = 0; Index < ARRAY_SIZE (mSignatureDatabase); Index++) {
+    if (StrCmp (mSignatureDatabase[Index].VariableName, VariableName) == 0) {
+      Snapshot = &mSignatureDatabase[Index];
+      break;
+    }
+  }
+
+  if (Snapshot == NULL) {
+    ASSERT (Snapshot != NULL);
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (!Snapshot->Valid) {
+    Snapshot->Data     = NULL;
+    Snapshot->DataSize = 0;
+    Snapshot->Status   = gRT->GetVariable (VariableName, &gEfiImageSecurityDatabaseGuid, NULL, &Snapshot->DataSize, NULL);
+    if (Snapshot->Status == EFI_BUFFER_TOO_SMALL) {
+      Snapshot->Data = (UINT8 *)AllocateZeroPool (Snapshot->DataSize);
+      if (Snapshot->Data == NULL) {
+        Snapshot->Status = EFI_OUT_OF_RESOURCES;
+      } else {
+        Snapshot->Status = gRT->GetVariable (VariableName, &gEfiImageSecurityDatabaseGuid, NULL, &Snapshot->DataSize, Snapshot->Data);
+      }
+    }
+
+    if (EFI_ERROR (Snapshot->Status)) {
+      if (Snapshot->Data != NULL) {
+        FreePool (Snapshot->Data);
+        Snapshot->Data = NULL;
+      }
+
+      Snapshot->DataSize = 0;
+    }
+
+    Snapshot->Valid = TRUE;
+  }
+
+  *Data     = Snapshot->Data;
+  *DataSize = Snapshot->DataSize;
+  return Snapshot->Status;
+}
+
+/**
+  Free the signature databases read during the verification of an image, so
+  that the next verification reads their current content.
+
+**/
+VOID
+FreeSignatureDatabases (
+  VOID
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < ARRAY_SIZE (mSignatureDatabase); Index++) {
+    if (mSignatureDatabase[Index].Data != NULL) {
+      FreePool (mSignatureDatabase[Index].Data);
+    }
+
+    mSignatureDatabase[Index].Valid    = FALSE;
+    mSignatureDatabase[Index].Data     = NULL;
+    mSignatureDatabase[Index].DataSize = 0;
+  }
+}
+
 /**
   Check whether the hash of an given X.509 certificate is in forbidden database (DBX).
 
@@ -857,6 +984,7 @@ IsCertHashFoundInDbx (
   UINTN               CertHashCount;
   UINTN               Index;
   UINT32              HashAlg;
+  UINT32              DigestAlg;
   VOID                *HashCtx;
   UINT8               CertDigest[MAX_DIGEST_SIZE];
   UINT8               *DbxCertHash;
@@ -868,8 +996,9 @@ IsCertHashFoundInDbx (
   *IsFound = FALSE;
   DbxList  = SignatureList;
   DbxSize  = SignatureListSize;
-  HashCtx  = NULL;
-  HashAlg  = HASHALG_MAX;
+  HashCtx   = NULL;
+  HashAlg   = HASHALG_MAX;
+  DigestAlg = HASHALG_MAX;
 
   if ((RevocationTime == NULL) || (DbxList == NULL)) {
     return EFI_INVALID_PARAMETER;
@@ -899,32 +1028,36 @@ IsCertHashFoundInDbx (
     }
 
     //
-    // Calculate the hash value of current TBSCertificate for comparision.
+    // Calculate the hash value of current TBSCertificate for comparision,
+    // unless the previous signature list already used the same algorithm.
     //
-    if (mHash[HashAlg].GetContextSize == NULL) {
-      goto Done;
-    }
+    if (HashAlg != DigestAlg) {
+      if (mHash[HashAlg].GetContextSize == NULL) {
+        goto Done;
+      }
 
-    ZeroMem (CertDigest, MAX_DIGEST_SIZE);
-    HashCtx = AllocatePool (mHash[HashAlg].GetContextSize ());
-    if (HashCtx == NULL) {
-      goto Done;
-    }
+      ZeroMem (CertDigest, MAX_DIGEST_SIZE);
+      HashCtx = AllocatePool (mHash[HashAlg].GetContextSize ());
+      if (HashCtx == NULL) {
+        goto Done;
+      }
 
-    if (!mHash[HashAlg].HashInit (HashCtx)) {
-      goto Done;
-    }
+      if (!mHash[HashAlg].HashInit (HashCtx)) {
+        goto Done;
+      }
 
-    if (!mHash[HashAlg].HashUpdate (HashCtx, TBSCert, TBSCertSize)) {
-      goto Done;
-    }
+      if (!mHash[HashAlg].HashUpdate (HashCtx, TBSCert, TBSCertSize)) {
+        goto Done;
+      }
 
-    if (!mHash[HashAlg].HashFinal (HashCtx, CertDigest)) {
-      goto Done;
-    }
+      if (!mHash[HashAlg].HashFinal (HashCtx, CertDigest)) {
+        goto Done;
+      }
 
-    FreePool (HashCtx);
-    HashCtx = NULL;
+      FreePool (HashCtx);
+      HashCtx   = NULL;
+      DigestAlg = HashAlg;
+    }
 
     SiglistHeaderSize = sizeof (EFI_SIGNATURE_LIST) + DbxList->SignatureHeaderSize;
     CertHash          = (EFI_SIGNATURE_DATA *)((UINT8 *)DbxList + SiglistHeaderSize);
@@ -999,10 +1132,8 @@ IsSignatureFoundInDatabase (
   // Read signature database variable.
   //
   *IsFound = FALSE;
-  Data     = NULL;
-  DataSize = 0;
-  Status   = gRT->GetVariable (VariableName, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, NULL);
-  if (Status != EFI_BUFFER_TOO_SMALL) {
+  Status   = GetSignatureDatabase (VariableName, &Data, &DataSize);
+  if (EFI_ERROR (Status)) {
     if (Status == EFI_NOT_FOUND) {
       //
       // No database, no need to search.
@@ -1013,16 +1144,6 @@ IsSignatureFoundInDatabase (
     return Status;
   }
 
-  Data = (UINT8 *)AllocateZeroPool (DataSize);
-  if (Data == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  Status = gRT->GetVariable (VariableName, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, Data);
-  if (EFI_ERROR (Status)) {
-    goto Done;
-  }
-
   //
   // Enumerate all signature data in SigDB to check if signature exists for executable.
   //
@@ -1059,11 +1180,6 @@ IsSignatureFoundInDatabase (
     CertList  = (EFI_SIGNATURE_LIST *)((UINT8 *)CertList + CertList->SignatureListSize);
   }
 
-Done:
-  if (Data != NULL) {
-    FreePool (Data);
-  }
-
   return Status;
 }
 
@@ -1175,18 +1291,7 @@ PassTimestampCheck (
   // RevocationTime is non-zero, the certificate should be considered to be revoked from that time and onwards.
   // Using the dbt to get the trusted TSA certificates.
   //
-  DbtDataSize = 0;
-  Status      = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE2, &gEfiImageSecurityDatabaseGuid, NULL, &DbtDataSize, NULL);
-  if (Status != EFI_BUFFER_TOO_SMALL) {
-    goto Done;
-  }
-
-  DbtData = (UINT8 *)AllocateZeroPool (DbtDataSize);
-  if (DbtData == NULL) {
-    goto Done;
-  }
-
-  Status = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE2, &gEfiImageSecurityDatabaseGuid, NULL, &DbtDataSize, (VOID *)DbtData);
+  Status = GetSignatureDatabase (EFI_IMAGE_SECURITY_DATABASE2, &DbtData, &DbtDataSize);
   if (EFI_ERROR (Status)) {
     goto Done;
   }
@@ -1224,10 +1329,6 @@ PassTimestampCheck (
   }
 
 Done:
-  if (DbtData != NULL) {
-    FreePool (DbtData);
-  }
-
   return VerifyStatus;
 }
 
@@ -1288,10 +1389,8 @@ IsForbiddenByDbx (
   //
   // The image will not be forbidden if dbx can't be got.
   //
-  DataSize = 0;
-  Status   = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE1, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, NULL);
-  ASSERT (EFI_ERROR (Status));
-  if (Status != EFI_BUFFER_TOO_SMALL) {
+  Status = GetSignatureDatabase (EFI_IMAGE_SECURITY_DATABASE1, &Data, &DataSize);
+  if (EFI_ERROR (Status)) {
     if (Status == EFI_NOT_FOUND) {
       //
       // Evidently not in dbx if the database doesn't exist.
@@ -1302,16 +1401,6 @@ IsForbiddenByDbx (
     return IsForbidden;
   }
 
-  Data = (UINT8 *)AllocateZeroPool (DataSize);
-  if (Data == NULL) {
-    return IsForbidden;
-  }
-
-  Status = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE1, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, (VOID *)Data);
-  if (EFI_ERROR (Status)) {
-    goto Done;
-  }
-
   //
   // Verify image signature with RAW X509 certificates in DBX database.
   // If passed, the image will be forbidden.
@@ -1418,10 +1507,6 @@ IsForbiddenByDbx (
   IsForbidden = FALSE;
 
 Done:
-  if (Data != NULL) {
-    FreePool (Data);
-  }
-
   Pkcs7FreeSigners (CertBuffer);
   Pkcs7FreeSigners (TrustedCert);
 
@@ -1471,21 +1556,9 @@ IsAllowedByDb (
   // Fetch 'db' content. If 'db' doesn't exist or encounters problem to get the
   // data, return not-allowed-by-db (FALSE).
   //
-  DataSize = 0;
-  Status   = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, NULL);
-  ASSERT (EFI_ERROR (Status));
-  if (Status != EFI_BUFFER_TOO_SMALL) {
-    return VerifyStatus;
-  }
-
-  Data = (UINT8 *)AllocateZeroPool (DataSize);
-  if (Data == NULL) {
-    return VerifyStatus;
-  }
-
-  Status = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, (VOID *)Data);
+  Status = GetSignatureDatabase (EFI_IMAGE_SECURITY_DATABASE, &Data, &DataSize);
   if (EFI_ERROR (Status)) {
-    goto Done;
+    return VerifyStatus;
   }
 
   //
@@ -1493,32 +1566,15 @@ IsAllowedByDb (
   // If any other errors occurred, no need to check 'db' but just return
   // not-allowed-by-db (FALSE) to avoid bypass.
   //
-  DbxDataSize = 0;
-  Status      = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE1, &gEfiImageSecurityDatabaseGuid, NULL, &DbxDataSize, NULL);
-  ASSERT (EFI_ERROR (Status));
-  if (Status != EFI_BUFFER_TOO_SMALL) {
-    if (Status != EFI_NOT_FOUND) {
-      goto Done;
-    }
-
-    //
-    // 'dbx' does not exist. Continue to check 'db'.
-    //
-  } else {
-    //
-    // 'dbx' exists. Get its content.
-    //
-    DbxData = (UINT8 *)AllocateZeroPool (DbxDataSize);
-    if (DbxData == NULL) {
-      goto Done;
-    }
-
-    Status = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE1, &gEfiImageSecurityDatabaseGuid, NULL, &DbxDataSize, (VOID *)DbxData);
-    if (EFI_ERROR (Status)) {
-      goto Done;
-    }
+  Status = GetSignatureDatabase (EFI_IMAGE_SECURITY_DATABASE1, &DbxData, &DbxDataSize);
+  if (EFI_ERROR (Status) && (Status != EFI_NOT_FOUND)) {
+    goto Done;
   }
 
+  //
+  // If 'dbx' does not exist, DbxData is NULL. Continue to check 'db'.
+  //
+
   //
   // Find X509 certificate in Signature List to verify the signature in pkcs7 signed data.
   //
@@ -1595,14 +1651,6 @@ Done:
     SecureBootHook (EFI_IMAGE_SECURITY_DATABASE, &gEfiImageSecurityDatabaseGuid, CertList->SignatureSize, CertData);
   }
 
-  if (Data != NULL) {
-    FreePool (Data);
-  }
-
-  if (DbxData != NULL) {
-    FreePool (DbxData);
-  }
-
   return VerifyStatus;
 }
 
@@ -1654,8 +1702,7 @@ Done:
 
 **/
 EFI_STATUS
-EFIAPI
-DxeImageVerificationHandler (
+VerifyImage (
   IN  UINT32                          AuthenticationStatus,
   IN  CONST EFI_DEVICE_PATH_PROTOCOL  *File  OPTIONAL,
   IN  VOID                            *FileBuffer,
@@ -2066,6 +2113,46 @@ Failed:
   return EFI_ACCESS_DENIED;
 }
 
+/**
+  Provide verification service for signed images. See VerifyImage() for the
+  verification flow.
+
+  The signature databases are read at most once while the image is verified,
+  and the time spent is recorded in the performance log.
+
+  @param[in]    AuthenticationStatus
+                           This is the authentication status returned from the security
+                           measurement services for the input file.
+  @param[in]    File       This is a pointer to the device path of the file that is
+                           being dispatched. This will optionally be used for logging.
+  @param[in]    FileBuffer File buffer matches the input file device path.
+  @param[in]    FileSize   Size of File buffer matches the input file device path.
+  @param[in]    BootPolicy A boot policy that was used to call LoadImage() UEFI service.
+
+  @return The status returned by VerifyImage().
+
+**/
+EFI_STATUS
+EFIAPI
+DxeImageVerificationHandler (
+  IN  UINT32                          AuthenticationStatus,
+  IN  CONST EFI_DEVICE_PATH_PROTOCOL  *File  OPTIONAL,
+  IN  VOID                            *FileBuffer,
+  IN  UINTN                           FileSize,
+  IN  BOOLEAN                         BootPolicy
+  )
+{
+  EFI_STATUS  Status;
+
+  PERF_INMODULE_BEGIN ("DxeImageVerify");
+  ZeroMem (mImageDigestCached, sizeof (mImageDigestCached));
+  Status = VerifyImage (AuthenticationStatus, File, FileBuffer, FileSize, BootPolicy);
+  FreeSignatureDatabases ();
+  PERF_INMODULE_END ("DxeImageVerify");
+
+  return Status;
+}
+
 /**
   On Ready To Boot Services Event notification handler.
 
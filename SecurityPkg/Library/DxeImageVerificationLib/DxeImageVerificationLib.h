@@ -195,4 +195,16 @@ typedef struct {
   HASH_FINAL               HashFinal;
 } HASH_TABLE;
 
+//
+// Content of a signature database variable (db, dbx or dbt), read at most
+// once during the verification of an image.
+//
+typedef struct {
+  CHAR16        *VariableName;
+  BOOLEAN       Valid;
+  EFI_STATUS    Status;
+  UINT8         *Data;
+  UINTN         DataSize;
+} SIGNATURE_DATABASE_SNAPSHOT;
+
 #endif
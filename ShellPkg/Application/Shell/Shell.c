@@ -3014,8 +3014,34 @@ RunScriptFileHandle (
     NewScriptFile->CurrentCommand->Cl   = CommandLine;
     NewScriptFile->CurrentCommand->Data = NULL;
     NewScriptFile->CurrentCommand->Line = LineCount;
+    InitializeListHead (&NewScriptFile->CurrentCommand->JumpList);
 
     InsertTailList (&NewScriptFile->CommandList, &NewScriptFile->CurrentCommand->Link);
+
+    //
+    // Remove the comments once here rather than each time the line is run, and
+    // remember whether the line needs the script parameters replaced.
+    //
+    NewScriptFile->CurrentCommand->Command = AllocateCopyPool (StrSize (CommandLine), CommandLine);
+    if (NewScriptFile->CurrentCommand->Command == NULL) {
+      DeleteScriptFileStruct (NewScriptFile);
+      return (EFI_OUT_OF_RESOURCES);
+    }
+
+    for (CommandLine3 = NewScriptFile->CurrentCommand->Command; *CommandLine3 != CHAR_NULL; CommandLine3++) {
+      if (*CommandLine3 == L'^') {
+        if ( *(CommandLine3+1) == L':') {
+          CopyMem (CommandLine3, CommandLine3+1, StrSize (CommandLine3) - sizeof (CommandLine3[0]));
+        } else if (*(CommandLine3+1) == L'#') {
+          CommandLine3++;
+        }
+      } else if (*CommandLine3 == L'#') {
+        *CommandLine3 = CHAR_NULL;
+        break;
+      } else if ((*CommandLine3 == L'%') && (*(CommandLine3+1) >= L'0') && (*(CommandLine3+1) <= L'9')) {
+        NewScriptFile->CurrentCommand->HasParameters = TRUE;
+      }
+    }
   }
 
   //
@@ -3048,27 +3074,12 @@ RunScriptFileHandle (
     StrnCpyS (
       CommandLine2,
       PrintBuffSize/sizeof (CHAR16),
-      NewScriptFile->CurrentCommand->Cl,
+      NewScriptFile->CurrentCommand->Command,
       PrintBuffSize/sizeof (CHAR16) - 1
       );
 
     SaveBufferList (&OldBufferList);
 
-    //
-    // NULL out comments
-    //
-    for (CommandLine3 = CommandLine2; CommandLine3 != NULL && *CommandLine3 != CHAR_NULL; CommandLine3++) {
-      if (*CommandLine3 == L'^') {
-        if ( *(CommandLine3+1) == L':') {
-          CopyMem (CommandLine3, CommandLine3+1, StrSize (CommandLine3) - sizeof (CommandLine3[0]));
-        } else if (*(CommandLine3+1) == L'#') {
-          CommandLine3++;
-        }
-      } else if (*CommandLine3 == L'#') {
-        *CommandLine3 = CHAR_NULL;
-      }
-    }
-
     if ((CommandLine2 != NULL) && (StrLen (CommandLine2) >= 1)) {
       //
       // Due to variability in starting the find and replace action we need to have both buffers the same.
@@ -3081,62 +3092,67 @@ RunScriptFileHandle (
         );
 
       //
-      // Remove the %0 to %9 from the command line (if we have some arguments)
+      // Lines that do not refer to the script parameters need no replacement.
       //
-      if (NewScriptFile->Argv != NULL) {
-        switch (NewScriptFile->Argc) {
-          default:
-            Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%9", NewScriptFile->Argv[9], FALSE, FALSE);
-            ASSERT_EFI_ERROR (Status);
-          case 9:
-            Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%8", NewScriptFile->Argv[8], FALSE, FALSE);
-            ASSERT_EFI_ERROR (Status);
-          case 8:
-            Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%7", NewScriptFile->Argv[7], FALSE, FALSE);
-            ASSERT_EFI_ERROR (Status);
-          case 7:
-            Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%6", NewScriptFile->Argv[6], FALSE, FALSE);
-            ASSERT_EFI_ERROR (Status);
-          case 6:
-            Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%5", NewScriptFile->Argv[5], FALSE, FALSE);
-            ASSERT_EFI_ERROR (Status);
-          case 5:
-            Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%4", NewScriptFile->Argv[4], FALSE, FALSE);
-            ASSERT_EFI_ERROR (Status);
-          case 4:
-            Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%3", NewScriptFile->Argv[3], FALSE, FALSE);
-            ASSERT_EFI_ERROR (Status);
-          case 3:
-            Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%2", NewScriptFile->Argv[2], FALSE, FALSE);
-            ASSERT_EFI_ERROR (Status);
-          case 2:
-            Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%1", NewScriptFile->Argv[1], FALSE, FALSE);
-            ASSERT_EFI_ERROR (Status);
-          case 1:
-            Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%0", NewScriptFile->Argv[0], FALSE, FALSE);
-            ASSERT_EFI_ERROR (Status);
-            break;
-          case 0:
-            break;
+      if (NewScriptFile->CurrentCommand->HasParameters) {
+        //
+        // Remove the %0 to %9 from the command line (if we have some arguments)
+        //
+        if (NewScriptFile->Argv != NULL) {
+          switch (NewScriptFile->Argc) {
+            default:
+              Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%9", NewScriptFile->Argv[9], FALSE, FALSE);
+              ASSERT_EFI_ERROR (Status);
+            case 9:
+              Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%8", NewScriptFile->Argv[8], FALSE, FALSE);
+              ASSERT_EFI_ERROR (Status);
+            case 8:
+              Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%7", NewScriptFile->Argv[7], FALSE, FALSE);
+              ASSERT_EFI_ERROR (Status);
+            case 7:
+              Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%6", NewScriptFile->Argv[6], FALSE, FALSE);
+              ASSERT_EFI_ERROR (Status);
+            case 6:
+              Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%5", NewScriptFile->Argv[5], FALSE, FALSE);
+              ASSERT_EFI_ERROR (Status);
+            case 5:
+              Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%4", NewScriptFile->Argv[4], FALSE, FALSE);
+              ASSERT_EFI_ERROR (Status);
+            case 4:
+              Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%3", NewScriptFile->Argv[3], FALSE, FALSE);
+              ASSERT_EFI_ERROR (Status);
+            case 3:
+              Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%2", NewScriptFile->Argv[2], FALSE, FALSE);
+              ASSERT_EFI_ERROR (Status);
+            case 2:
+              Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%1", NewScriptFile->Argv[1], FALSE, FALSE);
+              ASSERT_EFI_ERROR (Status);
+            case 1:
+              Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%0", NewScriptFile->Argv[0], FALSE, FALSE);
+              ASSERT_EFI_ERROR (Status);
+              break;
+            case 0:
+              break;
+          }
         }
-      }
-
-      Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%1", L"\"\"", FALSE, FALSE);
-      Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%2", L"\"\"", FALSE, FALSE);
-      Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%3", L"\"\"", FALSE, FALSE);
-      Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%4", L"\"\"", FALSE, FALSE);
-      Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%5", L"\"\"", FALSE, FALSE);
-      Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%6", L"\"\"", FALSE, FALSE);
-      Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%7", L"\"\"", FALSE, FALSE);
-      Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%8", L"\"\"", FALSE, FALSE);
-      Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%9", L"\"\"", FALSE, FALSE);
 
-      StrnCpyS (
-        CommandLine2,
-        PrintBuffSize/sizeof (CHAR16),
-        CommandLine,
-        PrintBuffSize/sizeof (CHAR16) - 1
-        );
+        Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%1", L"\"\"", FALSE, FALSE);
+        Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%2", L"\"\"", FALSE, FALSE);
+        Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%3", L"\"\"", FALSE, FALSE);
+        Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%4", L"\"\"", FALSE, FALSE);
+        Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%5", L"\"\"", FALSE, FALSE);
+        Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%6", L"\"\"", FALSE, FALSE);
+        Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%7", L"\"\"", FALSE, FALSE);
+        Status = ShellCopySearchAndReplace (CommandLine, CommandLine2, PrintBuffSize, L"%8", L"\"\"", FALSE, FALSE);
+        Status = ShellCopySearchAndReplace (CommandLine2, CommandLine, PrintBuffSize, L"%9", L"\"\"", FALSE, FALSE);
+
+        StrnCpyS (
+          CommandLine2,
+          PrintBuffSize/sizeof (CHAR16),
+          CommandLine,
+          PrintBuffSize/sizeof (CHAR16) - 1
+          );
+      }
 
       LastCommand = NewScriptFile->CurrentCommand;
 
@@ -377,13 +377,23 @@ ShellCommandGetScriptExit (
   );
 
 typedef struct {
-  LIST_ENTRY    Link;       ///< List enumerator items.
-  UINTN         Line;       ///< What line of the script file this was on.
-  CHAR16        *Cl;        ///< The original command line.
-  VOID          *Data;      ///< The data structure format dependant upon Command. (not always used)
-  BOOLEAN       Reset;      ///< Reset the command (it must be treated like a initial run (but it may have data already))
+  LIST_ENTRY    Link;          ///< List enumerator items.
+  UINTN         Line;          ///< What line of the script file this was on.
+  CHAR16        *Cl;           ///< The original command line.
+  VOID          *Data;         ///< The data structure format dependant upon Command. (not always used)
+  BOOLEAN       Reset;         ///< Reset the command (it must be treated like a initial run (but it may have data already))
+  CHAR16        *Command;      ///< The command line with comments removed, built when the script is loaded.
+  BOOLEAN       HasParameters; ///< TRUE if Command refers to the script parameters (%0 to %9).
+  LIST_ENTRY    JumpList;      ///< Flow control targets already resolved from this command (SCRIPT_JUMP objects).
 } SCRIPT_COMMAND_LIST;
 
+typedef struct {
+  LIST_ENTRY             Link;    ///< List enumerator items.
+  CHAR16                 *Key;    ///< The description of the search, as built by the flow control command.
+  BOOLEAN                Found;   ///< TRUE if the search found its target.
+  SCRIPT_COMMAND_LIST    *Target; ///< The command the search moves to, if Found.
+} SCRIPT_JUMP;
+
 typedef struct {
   CHAR16                 *ScriptName;     ///< The filename of this script.
   CHAR16                 **Argv;          ///< The parmameters to the script file.
@@ -25,6 +25,14 @@ STATIC UINTN                              mFsMaxCount  = 0;
 STATIC UINTN                              mBlkMaxCount = 0;
 STATIC BUFFER_LIST                        mFileHandleList;
 
+//
+// Direct-mapped cache of the internal commands found by name, indexed by a
+// hash of the upper-cased name. Scripts look the same few commands up several
+// times per line; a hit avoids walking the whole command list.
+//
+#define COMMAND_CACHE_SIZE  64
+STATIC SHELL_COMMAND_INTERNAL_LIST_ENTRY  *mCommandCache[COMMAND_CACHE_SIZE];
+
 STATIC CONST CHAR8  Hex[] = {
   '0',
   '1',
@@ -241,6 +249,7 @@ ShellCommandLibDestructor (
   //
   // enumerate throught the list and free all the memory
   //
+  ZeroMem (mCommandCache, sizeof (mCommandCache));
   while (!IsListEmpty (&mCommandList.Link)) {
     Node = (SHELL_COMMAND_INTERNAL_LIST_ENTRY *)GetFirstNode (&mCommandList.Link);
     RemoveEntryList (&Node->Link);
@@ -374,25 +383,37 @@ ShellCommandDynamicCommandExists (
 }
 
 /**
-  Checks if a command is already on the internal command list.
+  Find a command on the internal command list.
 
-  @param[in] CommandString        The command string to check for on the list.
+  @param[in] CommandString        The command name, compared without case.
+
+  @return The list entry of the command, or NULL if it is not an internal command.
 **/
-BOOLEAN
-ShellCommandIsCommandOnInternalList (
+STATIC
+SHELL_COMMAND_INTERNAL_LIST_ENTRY *
+ShellCommandFindInternalCommand (
   IN CONST  CHAR16  *CommandString
   )
 {
   SHELL_COMMAND_INTERNAL_LIST_ENTRY  *Node;
+  CONST CHAR16                       *Walker;
+  UINTN                              Hash;
 
-  //
-  // assert for NULL parameter
-  //
   ASSERT (CommandString != NULL);
 
-  //
-  // check for the command
-  //
+  Hash = 0;
+  for (Walker = CommandString; *Walker != CHAR_NULL; Walker++) {
+    Hash = Hash * 31 + CharToUpper (*Walker);
+  }
+
+  Hash %= COMMAND_CACHE_SIZE;
+  Node  = mCommandCache[Hash];
+  if ((Node != NULL) &&
+      (gUnicodeCollation->StriColl (gUnicodeCollation, (CHAR16 *)CommandString, Node->CommandString) == 0))
+  {
+    return (Node);
+  }
+
   for ( Node = (SHELL_COMMAND_INTERNAL_LIST_ENTRY *)GetFirstNode (&mCommandList.Link)
         ; !IsNull (&mCommandList.Link, &Node->Link)
         ; Node = (SHELL_COMMAND_INTERNAL_LIST_ENTRY *)GetNextNode (&mCommandList.Link, &Node->Link)
@@ -406,11 +427,33 @@ ShellCommandIsCommandOnInternalList (
                              ) == 0
         )
     {
-      return (TRUE);
+      mCommandCache[Hash] = Node;
+      return (Node);
     }
   }
 
-  return (FALSE);
+  return (NULL);
+}
+
+/**
+  Checks if a command is already on the internal command list.
+
+  @param[in] CommandString        The command string to check for on the list.
+**/
+BOOLEAN
+ShellCommandIsCommandOnInternalList (
+  IN CONST  CHAR16  *CommandString
+  )
+{
+  //
+  // assert for NULL parameter
+  //
+  ASSERT (CommandString != NULL);
+
+  //
+  // check for the command
+  //
+  return (BOOLEAN)(ShellCommandFindInternalCommand (CommandString) != NULL);
 }
 
 /**
@@ -480,21 +523,9 @@ ShellCommandGetInternalCommandHelp (
   //
   // check for the command
   //
-  for ( Node = (SHELL_COMMAND_INTERNAL_LIST_ENTRY *)GetFirstNode (&mCommandList.Link)
-        ; !IsNull (&mCommandList.Link, &Node->Link)
-        ; Node = (SHELL_COMMAND_INTERNAL_LIST_ENTRY *)GetNextNode (&mCommandList.Link, &Node->Link)
-        )
-  {
-    ASSERT (Node->CommandString != NULL);
-    if (gUnicodeCollation->StriColl (
-                             gUnicodeCollation,
-                             (CHAR16 *)CommandString,
-                             Node->CommandString
-                             ) == 0
-        )
-    {
-      return (HiiGetString (Node->HiiHandle, Node->ManFormatHelp, NULL));
-    }
+  Node = ShellCommandFindInternalCommand (CommandString);
+  if (Node != NULL) {
+    return (HiiGetString (Node->HiiHandle, Node->ManFormatHelp, NULL));
   }
 
   return (NULL);
@@ -753,31 +784,19 @@ ShellCommandRunCommandHandler (
   //
   // check for the command
   //
-  for ( Node = (SHELL_COMMAND_INTERNAL_LIST_ENTRY *)GetFirstNode (&mCommandList.Link)
-        ; !IsNull (&mCommandList.Link, &Node->Link)
-        ; Node = (SHELL_COMMAND_INTERNAL_LIST_ENTRY *)GetNextNode (&mCommandList.Link, &Node->Link)
-        )
-  {
-    ASSERT (Node->CommandString != NULL);
-    if (gUnicodeCollation->StriColl (
-                             gUnicodeCollation,
-                             (CHAR16 *)CommandString,
-                             Node->CommandString
-                             ) == 0
-        )
-    {
-      if (CanAffectLE != NULL) {
-        *CanAffectLE = Node->LastError;
-      }
-
-      if (RetVal != NULL) {
-        *RetVal = Node->CommandHandler (NULL, gST);
-      } else {
-        Node->CommandHandler (NULL, gST);
-      }
+  Node = ShellCommandFindInternalCommand (CommandString);
+  if (Node != NULL) {
+    if (CanAffectLE != NULL) {
+      *CanAffectLE = Node->LastError;
+    }
 
-      return (RETURN_SUCCESS);
+    if (RetVal != NULL) {
+      *RetVal = Node->CommandHandler (NULL, gST);
+    } else {
+      Node->CommandHandler (NULL, gST);
     }
+
+    return (RETURN_SUCCESS);
   }
 
   //
@@ -826,21 +845,9 @@ ShellCommandGetManFileNameHandler (
   //
   // check for the command
   //
-  for ( Node = (SHELL_COMMAND_INTERNAL_LIST_ENTRY *)GetFirstNode (&mCommandList.Link)
-        ; !IsNull (&mCommandList.Link, &Node->Link)
-        ; Node = (SHELL_COMMAND_INTERNAL_LIST_ENTRY *)GetNextNode (&mCommandList.Link, &Node->Link)
-        )
-  {
-    ASSERT (Node->CommandString != NULL);
-    if (gUnicodeCollation->StriColl (
-                             gUnicodeCollation,
-                             (CHAR16 *)CommandString,
-                             Node->CommandString
-                             ) == 0
-        )
-    {
-      return (Node->GetManFileName ());
-    }
+  Node = ShellCommandFindInternalCommand (CommandString);
+  if (Node != NULL) {
+    return (Node->GetManFileName ());
   }
 
   return (NULL);
@@ -1142,7 +1149,8 @@ DeleteScriptFileStruct (
   IN SCRIPT_FILE  *Script
   )
 {
-  UINT8  LoopVar;
+  UINT8        LoopVar;
+  SCRIPT_JUMP  *Jump;
 
   if (Script == NULL) {
     return;
@@ -1169,6 +1177,15 @@ DeleteScriptFileStruct (
         SHELL_FREE_NON_NULL (Script->CurrentCommand->Data);
       }
 
+      SHELL_FREE_NON_NULL (Script->CurrentCommand->Command);
+
+      while (!IsListEmpty (&Script->CurrentCommand->JumpList)) {
+        Jump = (SCRIPT_JUMP *)GetFirstNode (&Script->CurrentCommand->JumpList);
+        RemoveEntryList (&Jump->Link);
+        SHELL_FREE_NON_NULL (Jump->Key);
+        FreePool (Jump);
+      }
+
       SHELL_FREE_NON_NULL (Script->CurrentCommand);
     }
   }
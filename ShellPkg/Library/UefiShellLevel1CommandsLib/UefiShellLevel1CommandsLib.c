@@ -259,6 +259,9 @@ MoveToTag (
   )
 {
   SCRIPT_COMMAND_LIST  *CommandNode;
+  SCRIPT_COMMAND_LIST  *StartNode;
+  SCRIPT_JUMP          *Jump;
+  CHAR16               *Key;
   BOOLEAN              Found;
   UINTN                TargetCount;
 
@@ -272,6 +275,44 @@ MoveToTag (
     return FALSE;
   }
 
+  //
+  // The script does not change while it runs, so a given search from a given
+  // command always ends on the same target. Reuse the result of an earlier
+  // search, so that loops do not rescan their body on every iteration.
+  //
+  StartNode = ScriptFile->CurrentCommand;
+  Key       = CatSPrint (
+                NULL,
+                L"%p %d %d %d %s %s %s",
+                Function,
+                MovePast,
+                WrapAroundScript,
+                Label != NULL,
+                DecrementerTag,
+                IncrementerTag,
+                Label != NULL ? Label : L""
+                );
+  if (Key != NULL) {
+    for ( Jump = (SCRIPT_JUMP *)GetFirstNode (&StartNode->JumpList)
+          ; !IsNull (&StartNode->JumpList, &Jump->Link)
+          ; Jump = (SCRIPT_JUMP *)GetNextNode (&StartNode->JumpList, &Jump->Link)
+          )
+    {
+      if (StrCmp (Jump->Key, Key) == 0) {
+        FreePool (Key);
+        if (Jump->Found && !FindOnly) {
+          ScriptFile->CurrentCommand = Jump->Target;
+        }
+
+        return (Jump->Found);
+      }
+    }
+  }
+
+  //
+  // Always locate the target so that it can be remembered, and put back the
+  // current command afterwards if only a find was requested.
+  //
   for (CommandNode = (SCRIPT_COMMAND_LIST *)(*Function)(&ScriptFile->CommandList, &ScriptFile->CurrentCommand->Link), Found = FALSE
        ; !IsNull (&ScriptFile->CommandList, &CommandNode->Link) && !Found
        ; CommandNode = (SCRIPT_COMMAND_LIST *)(*Function)(&ScriptFile->CommandList, &CommandNode->Link)
@@ -284,7 +325,7 @@ MoveToTag (
               Label,
               ScriptFile,
               MovePast,
-              FindOnly,
+              FALSE,
               CommandNode,
               &TargetCount
               );
@@ -303,12 +344,28 @@ MoveToTag (
                 Label,
                 ScriptFile,
                 MovePast,
-                FindOnly,
+                FALSE,
                 CommandNode,
                 &TargetCount
                 );
     }
   }
 
+  if (Key != NULL) {
+    Jump = AllocateZeroPool (sizeof (SCRIPT_JUMP));
+    if (Jump != NULL) {
+      Jump->Key    = Key;
+      Jump->Found  = Found;
+      Jump->Target = Found ? ScriptFile->CurrentCommand : NULL;
+      InsertTailList (&StartNode->JumpList, &Jump->Link);
+    } else {
+      FreePool (Key);
+    }
+  }
+
+  if (FindOnly) {
+    ScriptFile->CurrentCommand = StartNode;
+  }
+
   return (Found);
 }
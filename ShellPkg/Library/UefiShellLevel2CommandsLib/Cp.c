@@ -11,6 +11,17 @@
 #include <Guid/FileSystemInfo.h>
 #include <Guid/FileSystemVolumeLabelInfo.h>
 
+//
+// Size of each of the two buffers used when reads and writes are overlapped.
+//
+#define CP_ASYNC_BUFFER_SIZE  SIZE_1MB
+
+//
+// Resolution of the timer used to measure the copy throughput. The elapsed
+// time is displayed with one decimal.
+//
+#define CP_TIMER_TICKS_PER_SECOND  10
+
 /**
   Function to take a list of files to copy and a destination location and do
   the verification and copying of those files to that location.  This function
@@ -21,6 +32,7 @@
   @param[in] SilentMode         TRUE to eliminate screen output.
   @param[in] RecursiveMode      TRUE to copy directories.
   @param[in] Resp               The response to the overwrite query (if always).
+  @param[in] ReportThroughput   TRUE to display the throughput of each file copy.
 
   @retval SHELL_SUCCESS             the files were all moved.
   @retval SHELL_INVALID_PARAMETER   a parameter was invalid
@@ -34,9 +46,239 @@ ValidateAndCopyFiles (
   IN CONST CHAR16               *DestDir,
   IN BOOLEAN                    SilentMode,
   IN BOOLEAN                    RecursiveMode,
-  IN VOID                       **Resp
+  IN VOID                       **Resp,
+  IN BOOLEAN                    ReportThroughput
   );
 
+/**
+  Timer notification function counting the elapsed periods of a copy.
+
+  @param[in] Event    The timer event.
+  @param[in] Context  Pointer to the UINTN tick counter.
+**/
+STATIC
+VOID
+EFIAPI
+CpTimerTick (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  (*(UINTN *)Context)++;
+}
+
+/**
+  Get the optimal transfer size of the block device holding a file.
+
+  @param[in] Path   The path of the file.
+
+  @return The size in bytes of the optimal transfer granularity of the device,
+          the block size if the device does not report one, or 0 if the file
+          is not on a block device.
+**/
+STATIC
+UINTN
+CpGetOptimalTransferSize (
+  IN CONST CHAR16  *Path
+  )
+{
+  EFI_DEVICE_PATH_PROTOCOL  *FilePath;
+  EFI_DEVICE_PATH_PROTOCOL  *DevicePath;
+  EFI_HANDLE                Handle;
+  EFI_BLOCK_IO_PROTOCOL     *BlockIo;
+  EFI_STATUS                Status;
+  UINTN                     TransferSize;
+
+  TransferSize = 0;
+  FilePath     = gEfiShellProtocol->GetDevicePathFromFilePath (Path);
+  if (FilePath == NULL) {
+    return 0;
+  }
+
+  DevicePath = FilePath;
+  Status     = gBS->LocateDevicePath (&gEfiBlockIoProtocolGuid, &DevicePath, &Handle);
+  if (!EFI_ERROR (Status)) {
+    Status = gBS->HandleProtocol (Handle, &gEfiBlockIoProtocolGuid, (VOID **)&BlockIo);
+    if (!EFI_ERROR (Status)) {
+      TransferSize = BlockIo->Media->BlockSize;
+      if ((BlockIo->Revision >= EFI_BLOCK_IO_PROTOCOL_REVISION3) &&
+          (BlockIo->Media->OptimalTransferLengthGranularity != 0))
+      {
+        TransferSize *= BlockIo->Media->OptimalTransferLengthGranularity;
+      }
+    }
+  }
+
+  FreePool (FilePath);
+  return TransferSize;
+}
+
+/**
+  Wait for an asynchronous file request to complete.
+
+  @param[in] Token  The token of the request.
+
+  @return The completion status of the request.
+**/
+STATIC
+EFI_STATUS
+CpWaitForToken (
+  IN EFI_FILE_IO_TOKEN  *Token
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Index;
+
+  Status = gBS->WaitForEvent (1, &Token->Event, &Index);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return Token->Status;
+}
+
+/**
+  Copy the data of a file with two buffers, so that reading the next chunk of
+  the source overlaps with writing the previous one to the destination.
+
+  Both files must be positioned at their start.
+
+  @param[in] SourceFp     The source file.
+  @param[in] DestFp       The destination file.
+  @param[in] BufferSize   The size of each of the two buffers.
+  @param[out] WriteFailed TRUE if an error was returned while writing the
+                          destination, FALSE if it was returned while reading.
+
+  @retval EFI_SUCCESS       The data was copied.
+  @retval EFI_UNSUPPORTED   The files do not support asynchronous I/O or the
+                            buffers could not be allocated; no data was
+                            copied.
+  @retval Others            The error returned by the failing request.
+**/
+STATIC
+EFI_STATUS
+CpCopyFileDataAsync (
+  IN  EFI_FILE_PROTOCOL  *SourceFp,
+  IN  EFI_FILE_PROTOCOL  *DestFp,
+  IN  UINTN              BufferSize,
+  OUT BOOLEAN            *WriteFailed
+  )
+{
+  EFI_FILE_IO_TOKEN  ReadToken;
+  EFI_FILE_IO_TOKEN  WriteToken;
+  UINT8              *Buffer;
+  UINTN              Index;
+  BOOLEAN            WritePending;
+  BOOLEAN            FirstWrite;
+  EFI_STATUS         Status;
+  EFI_STATUS         WriteStatus;
+
+  *WriteFailed = FALSE;
+
+  if ((SourceFp->Revision < EFI_FILE_PROTOCOL_REVISION2) || (SourceFp->ReadEx == NULL) ||
+      (DestFp->Revision < EFI_FILE_PROTOCOL_REVISION2) || (DestFp->WriteEx == NULL))
+  {
+    return EFI_UNSUPPORTED;
+  }
+
+  ZeroMem (&ReadToken, sizeof (ReadToken));
+  ZeroMem (&WriteToken, sizeof (WriteToken));
+
+  Buffer = AllocatePool (BufferSize * 2);
+  if (Buffer == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &ReadToken.Event);
+  if (!EFI_ERROR (Status)) {
+    Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &WriteToken.Event);
+  }
+
+  if (EFI_ERROR (Status)) {
+    Status = EFI_UNSUPPORTED;
+    goto Exit;
+  }
+
+  Index        = 0;
+  WritePending = FALSE;
+  FirstWrite   = TRUE;
+
+  ReadToken.BufferSize = BufferSize;
+  ReadToken.Buffer     = Buffer;
+  Status               = SourceFp->ReadEx (SourceFp, &ReadToken);
+
+  while (!EFI_ERROR (Status)) {
+    Status = CpWaitForToken (&ReadToken);
+    if (EFI_ERROR (Status) || (ReadToken.BufferSize == 0)) {
+      break;
+    }
+
+    //
+    // The other buffer is still being written; wait for it before reusing the
+    // write token.
+    //
+    if (WritePending) {
+      WritePending = FALSE;
+      Status       = CpWaitForToken (&WriteToken);
+      if (EFI_ERROR (Status)) {
+        *WriteFailed = TRUE;
+        break;
+      }
+    }
+
+    WriteToken.BufferSize = ReadToken.BufferSize;
+    WriteToken.Buffer     = ReadToken.Buffer;
+    Status                = DestFp->WriteEx (DestFp, &WriteToken);
+    if (EFI_ERROR (Status)) {
+      if ((Status == EFI_UNSUPPORTED) && FirstWrite) {
+        //
+        // Rewind the source so the caller can copy synchronously instead.
+        //
+        SourceFp->SetPosition (SourceFp, 0);
+      } else {
+        *WriteFailed = TRUE;
+      }
+
+      break;
+    }
+
+    WritePending = TRUE;
+    FirstWrite   = FALSE;
+    if (ReadToken.BufferSize < BufferSize) {
+      break;
+    }
+
+    Index                ^= 1;
+    ReadToken.BufferSize  = BufferSize;
+    ReadToken.Buffer      = Buffer + Index * BufferSize;
+    Status                = SourceFp->ReadEx (SourceFp, &ReadToken);
+  }
+
+  if ((Status == EFI_UNSUPPORTED) && !FirstWrite) {
+    Status = EFI_DEVICE_ERROR;
+  }
+
+  if (WritePending) {
+    WriteStatus = CpWaitForToken (&WriteToken);
+    if (!EFI_ERROR (Status) && EFI_ERROR (WriteStatus)) {
+      Status       = WriteStatus;
+      *WriteFailed = TRUE;
+    }
+  }
+
+Exit:
+  if (ReadToken.Event != NULL) {
+    gBS->CloseEvent (ReadToken.Event);
+  }
+
+  if (WriteToken.Event != NULL) {
+    gBS->CloseEvent (WriteToken.Event);
+  }
+
+  FreePool (Buffer);
+  return Status;
+}
+
 /**
   Function to Copy one file to another location
 
@@ -47,6 +289,7 @@ ValidateAndCopyFiles (
   @param[out] Resp      pointer to response from question.  Pass back on looped calling
   @param[in] SilentMode whether to run in quiet mode or not
   @param[in] CmdName    Source command name requesting single file copy
+  @param[in] ReportThroughput TRUE to display the throughput of each file copy
 
   @retval SHELL_SUCCESS   The source file was copied to the destination
 **/
@@ -56,11 +299,19 @@ CopySingleFile (
   IN CONST CHAR16  *Dest,
   OUT VOID         **Resp,
   IN BOOLEAN       SilentMode,
-  IN CONST CHAR16  *CmdName
+  IN CONST CHAR16  *CmdName,
+  IN BOOLEAN       ReportThroughput
   )
 {
   VOID                  *Response;
   UINTN                 ReadSize;
+  UINTN                 AsyncBufferSize;
+  UINTN                 TransferSize;
+  UINT64                CopySize;
+  BOOLEAN               WriteFailed;
+  EFI_EVENT             CopyTimer;
+  UINTN                 CopyTicks;
+  UINT64                Rate;
   SHELL_FILE_HANDLE     SourceHandle;
   SHELL_FILE_HANDLE     DestHandle;
   EFI_STATUS            Status;
@@ -147,7 +398,7 @@ CopySingleFile (
       *TempName = CHAR_NULL;
       StrnCatGrow (&TempName, &Size, Dest, 0);
       StrnCatGrow (&TempName, &Size, L"\\", 0);
-      ShellStatus = ValidateAndCopyFiles (List, TempName, SilentMode, TRUE, Resp);
+      ShellStatus = ValidateAndCopyFiles (List, TempName, SilentMode, TRUE, Resp, ReportThroughput);
       ShellCloseFileMetaArg (&List);
       SHELL_FREE_NON_NULL (TempName);
       Size = 0;
@@ -178,6 +429,7 @@ CopySingleFile (
     //
     ShellGetFileSize (SourceHandle, &SourceFileSize);
     ShellGetFileSize (DestHandle, &DestFileSize);
+    CopySize = SourceFileSize;
 
     //
     // if the destination file already exists then it will be replaced, meaning the sourcefile effectively needs less storage space
@@ -222,28 +474,106 @@ CopySingleFile (
       ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_GEN_CPY_FAIL), gShellLevel2HiiHandle, CmdName);
       return (SHELL_VOLUME_FULL);
     } else {
+      CopyTimer = NULL;
+      CopyTicks = 0;
+      if (ReportThroughput) {
+        Status = gBS->CreateEvent (EVT_TIMER | EVT_NOTIFY_SIGNAL, TPL_NOTIFY, CpTimerTick, &CopyTicks, &CopyTimer);
+        if (!EFI_ERROR (Status)) {
+          Status = gBS->SetTimer (CopyTimer, TimerPeriodic, EFI_TIMER_PERIOD_MILLISECONDS (1000 / CP_TIMER_TICKS_PER_SECOND));
+          if (EFI_ERROR (Status)) {
+            gBS->CloseEvent (CopyTimer);
+            CopyTimer = NULL;
+          }
+        }
+      }
+
       //
-      // copy data between files
+      // Files spanning more than one large buffer are copied with two buffers,
+      // reading the next chunk while the previous one is written. The buffers
+      // are a multiple of the optimal transfer size of both devices.
       //
-      Buffer = AllocateZeroPool (ReadSize);
-      if (Buffer == NULL) {
-        ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_GEN_OUT_MEM), gShellLevel2HiiHandle, CmdName);
-        return SHELL_OUT_OF_RESOURCES;
+      Status          = EFI_UNSUPPORTED;
+      AsyncBufferSize = MAX (ReadSize, CP_ASYNC_BUFFER_SIZE);
+      TransferSize    = CpGetOptimalTransferSize (Source);
+      if (TransferSize != 0) {
+        AsyncBufferSize = ((AsyncBufferSize + TransferSize - 1) / TransferSize) * TransferSize;
       }
 
-      while (ReadSize == PcdGet32 (PcdShellFileOperationSize) && !EFI_ERROR (Status)) {
-        Status = ShellReadFile (SourceHandle, &ReadSize, Buffer);
-        if (!EFI_ERROR (Status)) {
-          Status = ShellWriteFile (DestHandle, &ReadSize, Buffer);
-          if (EFI_ERROR (Status)) {
-            ShellStatus = (SHELL_STATUS)(Status & (~MAX_BIT));
+      TransferSize = CpGetOptimalTransferSize (Dest);
+      if (TransferSize != 0) {
+        AsyncBufferSize = ((AsyncBufferSize + TransferSize - 1) / TransferSize) * TransferSize;
+      }
+
+      if (CopySize > AsyncBufferSize) {
+        Status = CpCopyFileDataAsync (
+                   ConvertShellHandleToEfiFileProtocol (SourceHandle),
+                   ConvertShellHandleToEfiFileProtocol (DestHandle),
+                   AsyncBufferSize,
+                   &WriteFailed
+                   );
+        if (EFI_ERROR (Status) && (Status != EFI_UNSUPPORTED)) {
+          ShellStatus = (SHELL_STATUS)(Status & (~MAX_BIT));
+          if (WriteFailed) {
             ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_GEN_CPY_WRITE_ERROR), gShellLevel2HiiHandle, CmdName, Dest);
+          } else {
+            ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_GEN_CPY_READ_ERROR), gShellLevel2HiiHandle, CmdName, Source);
+          }
+        }
+      }
+
+      if (Status == EFI_UNSUPPORTED) {
+        //
+        // copy data between files
+        //
+        Buffer = AllocateZeroPool (ReadSize);
+        if (Buffer == NULL) {
+          if (CopyTimer != NULL) {
+            gBS->CloseEvent (CopyTimer);
+          }
+
+          ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_GEN_OUT_MEM), gShellLevel2HiiHandle, CmdName);
+          return SHELL_OUT_OF_RESOURCES;
+        }
+
+        Status = EFI_SUCCESS;
+        while (ReadSize == PcdGet32 (PcdShellFileOperationSize) && !EFI_ERROR (Status)) {
+          Status = ShellReadFile (SourceHandle, &ReadSize, Buffer);
+          if (!EFI_ERROR (Status)) {
+            Status = ShellWriteFile (DestHandle, &ReadSize, Buffer);
+            if (EFI_ERROR (Status)) {
+              ShellStatus = (SHELL_STATUS)(Status & (~MAX_BIT));
+              ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_GEN_CPY_WRITE_ERROR), gShellLevel2HiiHandle, CmdName, Dest);
+              break;
+            }
+          } else {
+            ShellStatus = (SHELL_STATUS)(Status & (~MAX_BIT));
+            ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_GEN_CPY_READ_ERROR), gShellLevel2HiiHandle, CmdName, Source);
             break;
           }
-        } else {
-          ShellStatus = (SHELL_STATUS)(Status & (~MAX_BIT));
-          ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_GEN_CPY_READ_ERROR), gShellLevel2HiiHandle, CmdName, Source);
-          break;
+        }
+
+        FreePool (Buffer);
+      }
+
+      if (CopyTimer != NULL) {
+        gBS->CloseEvent (CopyTimer);
+        if (ShellStatus == SHELL_SUCCESS) {
+          //
+          // Report whole periods of the timer, at least one.
+          //
+          CopyTicks = MAX (CopyTicks, 1);
+          Rate      = DivU64x32 (MultU64x32 (CopySize, CP_TIMER_TICKS_PER_SECOND), (UINT32)(CopyTicks * SIZE_1KB));
+          ShellPrintHiiEx (
+            -1,
+            -1,
+            NULL,
+            STRING_TOKEN (STR_CP_THROUGHPUT),
+            gShellLevel2HiiHandle,
+            CopySize,
+            (UINT64)(CopyTicks / CP_TIMER_TICKS_PER_SECOND),
+            (UINT32)(CopyTicks % CP_TIMER_TICKS_PER_SECOND),
+            Rate
+            );
         }
       }
     }
@@ -283,6 +613,7 @@ CopySingleFile (
   @param[in] SilentMode         TRUE to eliminate screen output.
   @param[in] RecursiveMode      TRUE to copy directories.
   @param[in] Resp               The response to the overwrite query (if always).
+  @param[in] ReportThroughput   TRUE to display the throughput of each file copy.
 
   @retval SHELL_SUCCESS             the files were all moved.
   @retval SHELL_INVALID_PARAMETER   a parameter was invalid
@@ -296,7 +627,8 @@ ValidateAndCopyFiles (
   IN CONST CHAR16               *DestDir,
   IN BOOLEAN                    SilentMode,
   IN BOOLEAN                    RecursiveMode,
-  IN VOID                       **Resp
+  IN VOID                       **Resp,
+  IN BOOLEAN                    ReportThroughput
   )
 {
   CHAR16                     *HiiOutput;
@@ -556,7 +888,7 @@ ValidateAndCopyFiles (
     //
     // copy single file...
     //
-    ShellStatus = CopySingleFile (Node->FullName, DestPath, &Response, SilentMode, L"cp");
+    ShellStatus = CopySingleFile (Node->FullName, DestPath, &Response, SilentMode, L"cp", ReportThroughput);
     if (ShellStatus != SHELL_SUCCESS) {
       break;
     }
@@ -585,6 +917,7 @@ ValidateAndCopyFiles (
   @param[in] DestDir        The directory to copy files to.
   @param[in] SilentMode     TRUE to eliminate screen output.
   @param[in] RecursiveMode  TRUE to copy directories.
+  @param[in] ReportThroughput TRUE to display the throughput of each file copy.
 
   @retval SHELL_INVALID_PARAMETER   A parameter was invalid.
   @retval SHELL_SUCCESS             The operation was successful.
@@ -594,7 +927,8 @@ ProcessValidateAndCopyFiles (
   IN       EFI_SHELL_FILE_INFO  *FileList,
   IN CONST CHAR16               *DestDir,
   IN BOOLEAN                    SilentMode,
-  IN BOOLEAN                    RecursiveMode
+  IN BOOLEAN                    RecursiveMode,
+  IN BOOLEAN                    ReportThroughput
   )
 {
   SHELL_STATUS         ShellStatus;
@@ -619,14 +953,14 @@ ProcessValidateAndCopyFiles (
     StrnCatGrow (&FullName, NULL, ((EFI_SHELL_FILE_INFO *)List->Link.ForwardLink)->FullName, 0);
     ShellCloseFileMetaArg (&List);
     if ((FileInfo->Attribute & EFI_FILE_READ_ONLY) == 0) {
-      ShellStatus = ValidateAndCopyFiles (FileList, FullName, SilentMode, RecursiveMode, NULL);
+      ShellStatus = ValidateAndCopyFiles (FileList, FullName, SilentMode, RecursiveMode, NULL, ReportThroughput);
     } else {
       ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_CP_DEST_ERROR), gShellLevel2HiiHandle, L"cp");
       ShellStatus = SHELL_ACCESS_DENIED;
     }
   } else {
     ShellCloseFileMetaArg (&List);
-    ShellStatus = ValidateAndCopyFiles (FileList, DestDir, SilentMode, RecursiveMode, NULL);
+    ShellStatus = ValidateAndCopyFiles (FileList, DestDir, SilentMode, RecursiveMode, NULL, ReportThroughput);
   }
 
   SHELL_FREE_NON_NULL (FileInfo);
@@ -637,6 +971,7 @@ ProcessValidateAndCopyFiles (
 STATIC CONST SHELL_PARAM_ITEM  ParamList[] = {
   { L"-r", TypeFlag },
   { L"-q", TypeFlag },
+  { L"-v", TypeFlag },
   { NULL,  TypeMax  }
 };
 
@@ -662,6 +997,7 @@ ShellCommandRunCp (
   EFI_SHELL_FILE_INFO  *FileList;
   BOOLEAN              SilentMode;
   BOOLEAN              RecursiveMode;
+  BOOLEAN              ReportThroughput;
   CONST CHAR16         *Cwd;
   CHAR16               *FullCwd;
 
@@ -708,7 +1044,8 @@ ShellCommandRunCp (
       SilentMode = ShellCommandLineGetFlag (Package, L"-q");
     }
 
-    RecursiveMode = ShellCommandLineGetFlag (Package, L"-r");
+    RecursiveMode    = ShellCommandLineGetFlag (Package, L"-r");
+    ReportThroughput = ShellCommandLineGetFlag (Package, L"-v");
 
     switch (ParamCount = ShellCommandLineGetCount (Package)) {
       case 0:
@@ -739,7 +1076,7 @@ ShellCommandRunCp (
               ShellStatus = SHELL_OUT_OF_RESOURCES;
             } else {
               StrCpyS (FullCwd, StrSize (Cwd) / sizeof (CHAR16) + 1, Cwd);
-              ShellStatus = ProcessValidateAndCopyFiles (FileList, FullCwd, SilentMode, RecursiveMode);
+              ShellStatus = ProcessValidateAndCopyFiles (FileList, FullCwd, SilentMode, RecursiveMode, ReportThroughput);
               FreePool (FullCwd);
             }
           }
@@ -769,7 +1106,7 @@ ShellCommandRunCp (
           // now copy them all...
           //
           if ((FileList != NULL) && !IsListEmpty (&FileList->Link)) {
-            ShellStatus = ProcessValidateAndCopyFiles (FileList, PathCleanUpDirectories ((CHAR16 *)ShellCommandLineGetRawValue (Package, ParamCount)), SilentMode, RecursiveMode);
+            ShellStatus = ProcessValidateAndCopyFiles (FileList, PathCleanUpDirectories ((CHAR16 *)ShellCommandLineGetRawValue (Package, ParamCount)), SilentMode, RecursiveMode, ReportThroughput);
             Status      = ShellCloseFileMetaArg (&FileList);
             if (EFI_ERROR (Status) && (ShellStatus == SHELL_SUCCESS)) {
               ShellPrintHiiEx (-1, -1, NULL, STRING_TOKEN (STR_GEN_ERR_FILE), gShellLevel2HiiHandle, L"cp", ShellCommandLineGetRawValue (Package, ParamCount), ShellStatus|MAX_BIT);
@@ -373,7 +373,7 @@ MoveBetweenFileSystems (
   //
   // First we copy the file
   //
-  ShellStatus = CopySingleFile (Node->FullName, DestPath, Resp, TRUE, L"mv");
+  ShellStatus = CopySingleFile (Node->FullName, DestPath, Resp, TRUE, L"mv", FALSE);
 
   //
   // Check our result
@@ -25,6 +25,7 @@
 #include <Protocol/Shell.h>
 #include <Protocol/ShellParameters.h>
 #include <Protocol/DevicePath.h>
+#include <Protocol/BlockIo.h>
 #include <Protocol/LoadedImage.h>
 #include <Protocol/UnicodeCollation.h>
 
@@ -330,6 +331,7 @@ ShellCommandRunVol (
   @param[out] Resp      pointer to response from question.  Pass back on looped calling
   @param[in] SilentMode whether to run in quiet mode or not
   @param[in] CmdName    Source command name requesting single file copy
+  @param[in] ReportThroughput TRUE to display the throughput of each file copy
 
   @retval SHELL_SUCCESS   The source file was copied to the destination
 **/
@@ -339,7 +341,8 @@ CopySingleFile (
   IN CONST CHAR16  *Dest,
   OUT VOID         **Resp,
   IN BOOLEAN       SilentMode,
-  IN CONST CHAR16  *CmdName
+  IN CONST CHAR16  *CmdName,
+  IN BOOLEAN       ReportThroughput
   );
 
 /**